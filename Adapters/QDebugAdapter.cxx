@@ -0,0 +1,28 @@
+#include "QDebugAdapter.hxx"
+
+namespace ppxl {
+
+QDebug operator<<(QDebug p_debug, Point const& p_point) {
+  return p_debug << "(" << p_point.GetX() << "; " << p_point.GetY() << ")";
+}
+
+QDebug operator<<(QDebug p_debug, Vector const& p_vector) {
+  return p_debug << "(" << p_vector.GetX() << "; " << p_vector.GetY() << ")";
+}
+
+QDebug operator<<(QDebug p_debug, Segment const& p_segment) {
+  return p_debug << "[" << p_segment.GetA() << " " << p_segment.GetB() << "]";
+}
+
+QDebug operator<<(QDebug p_debug, Polygon const& p_polygon) {
+  auto const& vertices = p_polygon.GetVertices();
+
+  p_debug.nospace() << vertices.size() << ";";
+  for (unsigned k = 0; k < vertices.size(); k++) {
+    p_debug.nospace() << vertices.at(k) << ";";
+  }
+
+  return p_debug.maybeSpace();
+}
+
+}
@@ -0,0 +1,21 @@
+#ifndef QDEBUGADAPTER_HXX
+#define QDEBUGADAPTER_HXX
+
+#include "Core/Geometry/Point.hxx"
+#include "Core/Geometry/Vector.hxx"
+#include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/Polygon.hxx"
+
+#include <QDebug>
+
+// Qt formatting of the geometry, kept out of Core so that it does not depend on Qt.
+namespace ppxl {
+
+QDebug operator<<(QDebug p_debug, Point const& p_point);
+QDebug operator<<(QDebug p_debug, Vector const& p_vector);
+QDebug operator<<(QDebug p_debug, Segment const& p_segment);
+QDebug operator<<(QDebug p_debug, Polygon const& p_polygon);
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+#include "AllocationCounter.hxx"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<unsigned long> allocationsCount(0);
+
+}
+
+unsigned long AllocationCounter::GetAllocationsCount() {
+  return allocationsCount.load(std::memory_order_relaxed);
+}
+
+// Array and nothrow forms default to these, so that every allocation is counted once and freed by its match
+void* operator new(std::size_t p_size) {
+  allocationsCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(p_size == 0 ? 1 : p_size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p_pointer) noexcept {
+  std::free(p_pointer);
+}
+
+void operator delete(void* p_pointer, std::size_t) noexcept {
+  std::free(p_pointer);
+}
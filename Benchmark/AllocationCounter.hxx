@@ -0,0 +1,12 @@
+#ifndef ALLOCATIONCOUNTER_HXX
+#define ALLOCATIONCOUNTER_HXX
+
+// Counts the allocations of the program it is linked in, by replacing the global operator new.
+// The replacements live alone in their translation unit, away from the code they measure.
+class AllocationCounter {
+
+public:
+  static unsigned long GetAllocationsCount();
+};
+
+#endif
@@ -0,0 +1,283 @@
+#include "GestureReplay.hxx"
+#include "AllocationCounter.hxx"
+
+#include "Core/Objects/Deviations/Mirror.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Nearest rank percentile of sorted durations
+double Percentile(std::vector<double> const& p_sortedDurations, double p_percent) {
+  if (p_sortedDurations.empty()) {
+    return 0.;
+  }
+  auto rank = static_cast<std::size_t>(std::ceil(p_percent / 100. * p_sortedDurations.size()));
+  return p_sortedDurations[std::max<std::size_t>(rank, 1) - 1];
+}
+
+}
+
+GestureReplay::GestureReplay(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Object*> const& p_objectsList):
+  m_polygonsList(p_polygonsList),
+  m_objectsList(p_objectsList),
+  m_slicer(),
+  m_gesturesCount(0),
+  m_slicesCount(0),
+  m_residentSetSizes() {
+
+  m_slicer.SeObjectsList(m_objectsList);
+}
+
+bool GestureReplay::ReadGestures(std::string const& p_fileName, std::vector<Gesture>& p_gestures) {
+  std::ifstream file(p_fileName);
+  if (!file) {
+    return false;
+  }
+
+  Gesture gesture;
+  bool pressed = false;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream stream(line.substr(0, line.find('#')));
+    std::string event;
+    double x, y;
+    if (!(stream >> event)) {
+      continue;
+    }
+    if (!(stream >> x >> y)) {
+      return false;
+    }
+
+    if (event == "press") {
+      gesture = Gesture();
+      gesture.m_start = ppxl::Point(x, y);
+      pressed = true;
+    } else if (event == "move" && pressed) {
+      gesture.m_moves.emplace_back(x, y);
+    } else if (event == "release" && pressed) {
+      gesture.m_end = ppxl::Point(x, y);
+      p_gestures.push_back(gesture);
+      pressed = false;
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<Gesture> GestureReplay::GenerateGestures(std::vector<ppxl::Polygon> const& p_polygonsList, unsigned int p_count, double p_step, unsigned int p_seed) {
+  ppxl::BoundingBox box;
+  for (auto const& polygon: p_polygonsList) {
+    box.Extend(polygon.GetBoundingBox());
+  }
+
+  std::vector<Gesture> gestures;
+  if (box.IsEmpty()) {
+    return gestures;
+  }
+
+  // Gestures start and end a bit away from the polygons, as a player's do
+  double margin = 0.1 * std::max(box.GetXMax() - box.GetXMin(), box.GetYMax() - box.GetYMin());
+  box = box.Inflated(margin);
+  std::mt19937 generator(p_seed);
+  std::uniform_real_distribution<double> xDistribution(box.GetXMin(), box.GetXMax());
+  std::uniform_real_distribution<double> yDistribution(box.GetYMin(), box.GetYMax());
+
+  for (unsigned int k = 0; k < p_count; ++k) {
+    // Mouse events come in whole pixels
+    ppxl::Point start(std::round(xDistribution(generator)), std::round(yDistribution(generator)));
+    ppxl::Point end(std::round(xDistribution(generator)), std::round(yDistribution(generator)));
+
+    Gesture gesture;
+    gesture.m_start = start;
+    gesture.m_end = end;
+    auto movesCount = static_cast<unsigned int>(ppxl::Segment(start, end).Length() / p_step);
+    for (unsigned int i = 1; i <= movesCount; ++i) {
+      double t = static_cast<double>(i) / (movesCount+1);
+      gesture.m_moves.emplace_back(std::round(start.GetX() + t*(end.GetX() - start.GetX())), std::round(start.GetY() + t*(end.GetY() - start.GetY())));
+    }
+    gesture.m_moves.push_back(end);
+    gestures.push_back(gesture);
+  }
+
+  return gestures;
+}
+
+std::vector<ppxl::Polygon> GestureReplay::GenerateFragments(unsigned int p_count) {
+  auto columnsCount = static_cast<unsigned int>(std::ceil(std::sqrt(p_count)));
+  double cellSize = 1000. / std::max(columnsCount, 1u);
+
+  // A pixel of gap between neighbours, as between the pieces of a cut
+  std::vector<ppxl::Polygon> fragments;
+  for (unsigned int k = 0; k < p_count; ++k) {
+    double x = (k%columnsCount)*cellSize;
+    double y = (k/columnsCount)*cellSize;
+    fragments.emplace_back(std::vector<ppxl::Point>{
+      ppxl::Point(x+1., y+1.), ppxl::Point(x+cellSize-1., y+1.), ppxl::Point(x+cellSize-1., y+cellSize-1.), ppxl::Point(x+1., y+cellSize-1.)});
+  }
+
+  return fragments;
+}
+
+std::vector<Object*> GestureReplay::GenerateMirrors(unsigned int p_count, unsigned int p_seed) {
+  std::mt19937 generator(p_seed);
+  std::uniform_real_distribution<double> coordinateDistribution(0., 1000.);
+  std::uniform_real_distribution<double> angleDistribution(0., 2.*M_PI);
+  std::uniform_real_distribution<double> lengthDistribution(20., 100.);
+
+  std::vector<Object*> mirrors;
+  for (unsigned int k = 0; k < p_count; ++k) {
+    double x = std::round(coordinateDistribution(generator));
+    double y = std::round(coordinateDistribution(generator));
+    double angle = angleDistribution(generator);
+    double length = lengthDistribution(generator);
+    mirrors.push_back(new Mirror(x, y, std::round(x + length*std::cos(angle)), std::round(y + length*std::sin(angle))));
+  }
+
+  return mirrors;
+}
+
+template<typename Function>
+auto GestureReplay::Measure(Phase p_phase, Function p_function) {
+  PhaseSamples& samples = m_samples[p_phase];
+  unsigned long allocationsBefore = AllocationCounter::GetAllocationsCount();
+  auto start = std::chrono::steady_clock::now();
+  auto result = p_function();
+  auto end = std::chrono::steady_clock::now();
+  samples.m_allocationsCount += AllocationCounter::GetAllocationsCount() - allocationsBefore;
+  samples.m_durations.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  return result;
+}
+
+void GestureReplay::Replay(std::vector<Gesture> const& p_gestures) {
+  m_slicer.SetPolygonsList(m_polygonsList);
+  m_slicer.InitTotalOrientedArea();
+
+  // Reserve beforehand so that recording samples does not count as the phases' allocations
+  std::size_t movesCount = 0;
+  for (auto const& gesture: p_gestures) {
+    movesCount += gesture.m_moves.size();
+  }
+  m_samples[eComputeSlicingLines].m_durations.reserve(m_samples[eComputeSlicingLines].m_durations.size() + movesCount);
+  m_samples[eComputeLinesType].m_durations.reserve(m_samples[eComputeLinesType].m_durations.size() + movesCount);
+  m_samples[eSliceIt].m_durations.reserve(m_samples[eSliceIt].m_durations.size() + p_gestures.size());
+
+  Slicer::PolygonsChangeSet changeSet;
+  for (auto const& gesture: p_gestures) {
+    m_slicer.SetStartPoint(gesture.m_start);
+    for (auto const& move: gesture.m_moves) {
+      auto const* lines = Measure(eComputeSlicingLines, [&]() { return &m_slicer.ComputeSlicingLines(move); });
+      Measure(eComputeLinesType, [&]() { return m_slicer.ComputeLinesType(*lines); });
+    }
+    if (Measure(eSliceIt, [&]() { return m_slicer.SliceIt(gesture.m_end, changeSet); })) {
+      ++m_slicesCount;
+    }
+    ++m_gesturesCount;
+  }
+}
+
+void GestureReplay::WriteJson(std::ostream& p_os, std::string const& p_indent) const {
+  p_os << p_indent << "\"gestures\": " << m_gesturesCount << ",\n";
+  p_os << p_indent << "\"slices\": " << m_slicesCount << ",\n";
+  p_os << p_indent << "\"polygons\": " << m_slicer.GetPolygonsList().size() << ",\n";
+  p_os << p_indent << "\"phases\": {\n";
+  for (int phase = 0; phase < ePhasesCount; ++phase) {
+    PhaseSamples const& samples = m_samples[phase];
+    std::vector<double> durations(samples.m_durations);
+    std::sort(durations.begin(), durations.end());
+    double callsCount = std::max<std::size_t>(durations.size(), 1);
+
+    p_os << p_indent << "  \"" << GetPhaseName(static_cast<Phase>(phase)) << "\": {"
+         << "\"calls\": " << durations.size()
+         << ", \"p50_us\": " << Percentile(durations, 50.)
+         << ", \"p90_us\": " << Percentile(durations, 90.)
+         << ", \"p99_us\": " << Percentile(durations, 99.)
+         << ", \"max_us\": " << (durations.empty() ? 0. : durations.back())
+         << ", \"allocations\": " << samples.m_allocationsCount
+         << ", \"allocations_per_call\": " << samples.m_allocationsCount / callsCount
+         << "}" << (phase+1 < ePhasesCount ? "," : "") << "\n";
+  }
+  p_os << p_indent << "}";
+}
+
+void GestureReplay::Soak(std::vector<Gesture> const& p_gestures, unsigned long p_slicesCount, unsigned int p_checkpointsCount) {
+  m_residentSetSizes.clear();
+  m_residentSetSizes.reserve(p_checkpointsCount+1);
+  m_residentSetSizes.emplace_back(0, GetResidentSetSize());
+  unsigned long checkpointStep = std::max<unsigned long>(p_slicesCount/std::max(p_checkpointsCount, 1u), 1);
+
+  Slicer::PolygonsChangeSet changeSet;
+  unsigned long slicesCount = 0;
+  while (slicesCount < p_slicesCount) {
+    m_slicer.SetPolygonsList(m_polygonsList);
+    m_slicer.InitTotalOrientedArea();
+    bool sliced = false;
+    for (auto const& gesture: p_gestures) {
+      m_slicer.SetStartPoint(gesture.m_start);
+      changeSet = Slicer::PolygonsChangeSet();
+      if (!m_slicer.SliceIt(gesture.m_end, changeSet)) {
+        continue;
+      }
+      sliced = true;
+      ++slicesCount;
+      if (slicesCount%checkpointStep == 0) {
+        m_residentSetSizes.emplace_back(slicesCount, GetResidentSetSize());
+      }
+      if (slicesCount == p_slicesCount) {
+        break;
+      }
+    }
+    // None of the gestures cuts the level: it would never get to p_slicesCount
+    if (!sliced) {
+      break;
+    }
+  }
+}
+
+void GestureReplay::WriteSoakJson(std::ostream& p_os, std::string const& p_indent) const {
+  p_os << p_indent << "\"soak\": [";
+  for (unsigned int k = 0; k < m_residentSetSizes.size(); ++k) {
+    p_os << (k > 0 ? ", " : "") << "{\"slices\": " << m_residentSetSizes[k].first << ", \"rss_kb\": " << m_residentSetSizes[k].second << "}";
+  }
+  p_os << "]";
+}
+
+unsigned long GestureReplay::GetResidentSetSize() {
+  // Second field of statm, in pages
+  std::ifstream statm("/proc/self/statm");
+  unsigned long sizePages = 0;
+  unsigned long residentPages = 0;
+  if (!(statm >> sizePages >> residentPages)) {
+    return 0;
+  }
+#ifdef _SC_PAGESIZE
+  return residentPages * static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) / 1024;
+#else
+  return residentPages * 4;
+#endif
+}
+
+char const* GestureReplay::GetPhaseName(Phase p_phase) {
+  switch (p_phase) {
+  case eComputeSlicingLines:
+    return "ComputeSlicingLines";
+  case eComputeLinesType:
+    return "ComputeLinesType";
+  case eSliceIt:
+    return "SliceIt";
+  default:
+    return "Unknown";
+  }
+}
@@ -0,0 +1,78 @@
+#ifndef GESTUREREPLAY_HXX
+#define GESTUREREPLAY_HXX
+
+#include "Core/Slicer.hxx"
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Object;
+
+// A cut as the player draws it: pressed at m_start, dragged through m_moves, released at m_end.
+struct Gesture {
+  ppxl::Point m_start;
+  std::vector<ppxl::Point> m_moves;
+  ppxl::Point m_end;
+};
+
+// Replays gestures through a Slicer the way TestLevelController does, timing each phase
+// and counting the heap allocations it makes.
+class GestureReplay {
+
+public:
+  enum Phase {
+    eComputeSlicingLines,
+    eComputeLinesType,
+    eSliceIt,
+    ePhasesCount
+  };
+
+  GestureReplay(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Object*> const& p_objectsList);
+
+  // One "press x y", "move x y" or "release x y" per line, '#' starts a comment
+  static bool ReadGestures(std::string const& p_fileName, std::vector<Gesture>& p_gestures);
+  // Straight cuts across the polygons' bounding box, with a mouse move every p_step pixels
+  static std::vector<Gesture> GenerateGestures(std::vector<ppxl::Polygon> const& p_polygonsList, unsigned int p_count, double p_step, unsigned int p_seed);
+
+  // Synthetic levels on a 1000x1000 board: p_count squares on a grid, and p_count mirrors
+  // scattered over the board, to be deleted by the caller
+  static std::vector<ppxl::Polygon> GenerateFragments(unsigned int p_count);
+  static std::vector<Object*> GenerateMirrors(unsigned int p_count, unsigned int p_seed);
+
+  // Starts again from the level's polygons, then applies the gestures one after the other
+  void Replay(std::vector<Gesture> const& p_gestures);
+  void WriteJson(std::ostream& p_os, std::string const& p_indent) const;
+
+  // Slices along the gestures' end points, starting again from the level's polygons whenever
+  // they run out, until p_slicesCount slices were made. Nothing is recorded: the resident set
+  // size is read every p_slicesCount/p_checkpointsCount slices, and should stay flat.
+  void Soak(std::vector<Gesture> const& p_gestures, unsigned long p_slicesCount, unsigned int p_checkpointsCount);
+  void WriteSoakJson(std::ostream& p_os, std::string const& p_indent) const;
+
+  // In kilobytes, 0 where /proc/self/statm does not exist
+  static unsigned long GetResidentSetSize();
+
+  static char const* GetPhaseName(Phase p_phase);
+
+private:
+  struct PhaseSamples {
+    std::vector<double> m_durations;
+    unsigned long m_allocationsCount = 0;
+  };
+
+  template<typename Function>
+  auto Measure(Phase p_phase, Function p_function);
+
+  std::vector<ppxl::Polygon> m_polygonsList;
+  std::vector<Object*> m_objectsList;
+  Slicer m_slicer;
+  PhaseSamples m_samples[ePhasesCount];
+  unsigned int m_gesturesCount;
+  unsigned int m_slicesCount;
+  // Slices made and resident set size at each checkpoint of Soak
+  std::vector<std::pair<unsigned long, unsigned long>> m_residentSetSizes;
+};
+
+#endif
@@ -0,0 +1,31 @@
+#include "LegacyPoint.hxx"
+
+LegacyPoint::LegacyPoint(double p_x, double p_y) {
+  m_x = p_x;
+  m_y = p_y;
+}
+
+LegacyPoint::LegacyPoint(LegacyPoint const& p_point) {
+  m_x = p_point.m_x;
+  m_y = p_point.m_y;
+}
+
+LegacyPoint::~LegacyPoint() = default;
+
+LegacyPoint& LegacyPoint::operator=(LegacyPoint const& p_point) {
+  m_x = p_point.m_x;
+  m_y = p_point.m_y;
+  return *this;
+}
+
+LegacySegment::LegacySegment(LegacyPoint const& p_a, LegacyPoint const& p_b):
+  m_a(p_a),
+  m_b(p_b) {
+}
+
+LegacySegment::LegacySegment(LegacySegment const& p_segment):
+  m_a(p_segment.m_a),
+  m_b(p_segment.m_b) {
+}
+
+LegacySegment::~LegacySegment() = default;
@@ -0,0 +1,33 @@
+#ifndef LEGACYPOINT_HXX
+#define LEGACYPOINT_HXX
+
+// ppxl::Point and ppxl::Segment as they were before becoming plain values: a virtual destructor
+// and copies defined out of line, in LegacyPoint.cxx. Only kept to measure what that layout cost.
+class LegacyPoint {
+public:
+  LegacyPoint(double p_x = 0.0, double p_y = 0.0);
+  LegacyPoint(LegacyPoint const& p_point);
+  virtual ~LegacyPoint();
+
+  LegacyPoint& operator=(LegacyPoint const& p_point);
+
+  inline double GetX() const { return m_x; }
+  inline double GetY() const { return m_y; }
+
+private:
+  double m_x;
+  double m_y;
+};
+
+class LegacySegment {
+public:
+  LegacySegment(LegacyPoint const& p_a, LegacyPoint const& p_b);
+  LegacySegment(LegacySegment const& p_segment);
+  virtual ~LegacySegment();
+
+private:
+  LegacyPoint m_a;
+  LegacyPoint m_b;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "LegacySlicer.hxx"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+std::vector<ppxl::Polygon> LegacySlicer::ComputeNewPolygonList(ppxl::Polygon const& p_polygon, ppxl::Segment const& p_line, double p_orientedAreaTotal) {
+  std::vector<ppxl::Polygon> newPolygonList;
+  std::deque<ppxl::Point> points;
+  std::vector<ppxl::Point*> globalVertices;
+  std::vector<ppxl::Point*> intersections;
+  GetVerticesAndIntersections(p_line, p_polygon, points, globalVertices, intersections);
+
+  std::vector<ppxl::Point> newVertices;
+  std::vector<CuttingSegment> cuttingSegments = GetCuttingSegments(intersections);
+
+  while (StillHasBaseVertices(globalVertices, intersections)) {
+    // We really don't want the first point to be an intersection. Trust me.
+    ppxl::Point* p = globalVertices.at(0);
+    while (std::find(intersections.begin(), intersections.end(), p) != intersections.end()) {
+      globalVertices.erase(globalVertices.begin());
+      globalVertices.push_back(p);
+      p = globalVertices.at(0);
+    }
+    std::vector<ppxl::Point*> globalVerticesCopy(globalVertices);
+
+    bool lookingForOtherBound = false;
+    ppxl::Point* otherBound = nullptr;
+    for (ppxl::Point* currVertex: globalVerticesCopy) {
+      if (lookingForOtherBound) {
+        if (otherBound == currVertex) {
+          newVertices.push_back(*currVertex);
+          lookingForOtherBound = false;
+        }
+      } else {
+        if (std::find(intersections.begin(), intersections.end(), currVertex) != intersections.end()) {
+          // If the intersection is not equal to the last point, we add it
+          if (newVertices.size() > 0 && (std::find(newVertices.begin(), newVertices.end(), *currVertex) == newVertices.end())) {
+            newVertices.push_back(*currVertex);
+          }
+          otherBound = GetOtherBound(currVertex, cuttingSegments);
+          lookingForOtherBound = true;
+        } else {
+          newVertices.push_back(*currVertex);
+          auto it = std::find(globalVertices.begin(), globalVertices.end(), currVertex);
+          assert(it != globalVertices.end());
+          globalVertices.erase(it);
+        }
+      }
+    }
+
+    ppxl::Polygon newPolygon(newVertices);
+    if (std::round(10.0*newPolygon.OrientedArea() * 100.0 / p_orientedAreaTotal)/10.0 >= 0.1) {
+      newPolygonList.push_back(newPolygon);
+    }
+
+    newVertices.clear();
+  }
+
+  return newPolygonList;
+}
+
+void LegacySlicer::GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon, std::deque<ppxl::Point>& points,
+  std::vector<ppxl::Point*>& globalVertices, std::vector<ppxl::Point*>& intersections) {
+
+  std::vector<ppxl::Point> const& baseVertices = polygon.GetVertices();
+
+  for (unsigned int k = 0; k < baseVertices.size(); ++k) {
+    points.push_back(baseVertices.at(k));
+    ppxl::Point* A = &points.back();
+    ppxl::Segment AB(baseVertices.at(k), baseVertices.at((k+1)%baseVertices.size()));
+
+    globalVertices.push_back(A);
+
+    switch (AB.ComputeIntersection(line)) {
+    case ppxl::Segment::Regular:
+    {
+      points.push_back(ppxl::Segment::IntersectionPoint(AB, line));
+      globalVertices.push_back(&points.back());
+      intersections.push_back(&points.back());
+      break;
+    }
+    case ppxl::Segment::FirstVertexRegular:
+    {
+      points.push_back(baseVertices.at(k));
+      globalVertices.push_back(&points.back());
+      intersections.push_back(&points.back());
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  std::sort(intersections.begin(), intersections.end(), [](ppxl::Point const* p_point1, ppxl::Point const* p_point2) {
+    return *p_point1 < *p_point2;
+  });
+
+  CleanIntersections(polygon, intersections);
+}
+
+void LegacySlicer::CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point*>& intersections) {
+  if (intersections.size() < 2) {
+    intersections.clear();
+    return;
+  }
+
+  std::vector<ppxl::Point*> realIntersection;
+  bool inside = false;
+
+  for (unsigned int k = 0; k < intersections.size()-1; ++k) {
+    ppxl::Segment AB(*intersections.at(k), *intersections.at(k+1));
+    if (polygon.IsPointInside(AB.GetCenter())) {
+      if (!inside) {
+        realIntersection.push_back(intersections.at(k));
+        inside = true;
+      }
+    } else {
+      if (inside) {
+        realIntersection.push_back(intersections.at(k));
+        inside = false;
+      }
+    }
+  }
+
+  // Handle last vertex
+  if (inside) {
+    realIntersection.push_back(intersections.at(intersections.size()-1));
+  }
+
+  intersections = realIntersection;
+}
+
+std::vector<LegacySlicer::CuttingSegment> LegacySlicer::GetCuttingSegments(std::vector<ppxl::Point*> const& intersections) {
+  assert(intersections.size()%2 == 0);
+
+  std::vector<CuttingSegment> cuttingSegments;
+  for (unsigned int k = 0; k+1 < intersections.size(); k += 2) {
+    cuttingSegments.emplace_back(intersections.at(k), intersections.at(k+1));
+  }
+
+  return cuttingSegments;
+}
+
+bool LegacySlicer::StillHasBaseVertices(std::vector<ppxl::Point*> const& globalVertices, std::vector<ppxl::Point*> const& intersections) {
+  for (ppxl::Point* p: globalVertices) {
+    if (std::find(intersections.begin(), intersections.end(), p) == intersections.end()) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+ppxl::Point* LegacySlicer::GetOtherBound(ppxl::Point const* intersection, std::vector<CuttingSegment> const& cuttingSegments) {
+  for (CuttingSegment const& cuttingSegment: cuttingSegments) {
+    if (cuttingSegment.first == intersection) {
+      return cuttingSegment.second;
+    } else if (cuttingSegment.second == intersection) {
+      return cuttingSegment.first;
+    }
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,28 @@
+#ifndef LEGACYSLICER_HXX
+#define LEGACYSLICER_HXX
+
+#include "Core/Geometry/Polygon.hxx"
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+// Slicer::ComputeNewPolygonList as it was before the vertex pool, on points linked by address:
+// the reference the current slicer is compared with. Points live in a deque instead of leaking.
+class LegacySlicer {
+
+public:
+  static std::vector<ppxl::Polygon> ComputeNewPolygonList(ppxl::Polygon const& p_polygon, ppxl::Segment const& p_line, double p_orientedAreaTotal);
+
+private:
+  using CuttingSegment = std::pair<ppxl::Point*, ppxl::Point*>;
+
+  static void GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon, std::deque<ppxl::Point>& points,
+    std::vector<ppxl::Point*>& globalVertices, std::vector<ppxl::Point*>& intersections);
+  static void CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point*>& intersections);
+  static std::vector<CuttingSegment> GetCuttingSegments(std::vector<ppxl::Point*> const& intersections);
+  static bool StillHasBaseVertices(std::vector<ppxl::Point*> const& globalVertices, std::vector<ppxl::Point*> const& intersections);
+  static ppxl::Point* GetOtherBound(ppxl::Point const* intersection, std::vector<CuttingSegment> const& cuttingSegments);
+};
+
+#endif
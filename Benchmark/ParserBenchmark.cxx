@@ -0,0 +1,254 @@
+#include "Parser/BinaryLevel.hxx"
+#include "Parser/Parser.hxx"
+#include "Parser/Serializer.hxx"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// As many polygons as objects, spread over a 1000x1000 board
+void WriteSyntheticLevel(QString const& p_fileName, int p_elementsCount, unsigned int p_seed) {
+  std::mt19937 generator(p_seed);
+  std::uniform_int_distribution<int> coordinate(0, 1000);
+  std::uniform_int_distribution<int> size(5, 40);
+
+  QList<ppxl::Polygon> polygonsList;
+  for (int k = 0; k < p_elementsCount; ++k) {
+    double x = coordinate(generator);
+    double y = coordinate(generator);
+    double w = size(generator);
+    double h = size(generator);
+    polygonsList << ppxl::Polygon({ppxl::Point(x, y), ppxl::Point(x+w, y), ppxl::Point(x+w, y+h), ppxl::Point(x, y+h)});
+  }
+
+  QList<Tape*> tapesList;
+  QList<OneWay*> oneWaysList;
+  QList<Mirror*> mirrorsList;
+  QList<Portal*> portalsList;
+  for (int k = 0; k < p_elementsCount; ++k) {
+    double x = coordinate(generator);
+    double y = coordinate(generator);
+    double w = size(generator);
+    double h = size(generator);
+    switch (k%4) {
+    case 0:
+      tapesList << new Tape(x, y, w, h);
+      break;
+    case 1:
+      oneWaysList << new OneWay(x, y, x+w, y+h);
+      break;
+    case 2:
+      mirrorsList << new Mirror(x, y, x+w, y+h);
+      break;
+    default:
+      portalsList << new Portal(x, y, x+w, y, x, y+h, x+w, y+h);
+      break;
+    }
+  }
+
+  Serializer serializer(p_fileName);
+  serializer.SetLinesGoal(1);
+  serializer.SetPartsGoal(2);
+  serializer.SetMaxGapToWin(10);
+  serializer.SetTolerance(1);
+  serializer.SetStarsCount(3);
+  serializer.SetPolygonsList(polygonsList);
+  serializer.SetTapeList(tapesList);
+  serializer.SetOneWaysList(oneWaysList);
+  serializer.SetMirrorsList(mirrorsList);
+  serializer.SetPortalsList(portalsList);
+  serializer.WriteXML();
+
+  qDeleteAll(tapesList);
+  qDeleteAll(oneWaysList);
+  qDeleteAll(mirrorsList);
+  qDeleteAll(portalsList);
+}
+
+// Median time Parser takes to load p_fileName
+double MedianLoadingTime(QString const& p_fileName, int p_repeatCount, int& p_loadedCount) {
+  std::vector<double> durations;
+  for (int repeat = 0; repeat < p_repeatCount; ++repeat) {
+    auto start = std::chrono::steady_clock::now();
+    Parser parser(p_fileName);
+    auto end = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    p_loadedCount = parser.GetPolygonNodesCount() + parser.GetTapesList().size() + parser.GetOneWaysList().size()
+      + parser.GetMirrorsList().size() + parser.GetPortalsList().size();
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size()/2];
+}
+
+// Median time Serializer takes to save p_level, temporary file and rename included
+double MedianSavingTime(Level const& p_level, QString const& p_fileName, int p_repeatCount) {
+  std::vector<double> durations;
+  for (int repeat = 0; repeat < p_repeatCount; ++repeat) {
+    auto start = std::chrono::steady_clock::now();
+    Serializer::WriteLevel(p_level, p_fileName);
+    auto end = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  std::sort(durations.begin(), durations.end());
+  return durations[durations.size()/2];
+}
+
+// Point's operator== has a tolerance, while a round trip must not move a single coordinate
+bool AreSamePoints(ppxl::Point const& p_point, ppxl::Point const& p_otherPoint) {
+  return p_point.GetX() == p_otherPoint.GetX() && p_point.GetY() == p_otherPoint.GetY();
+}
+
+bool AreSameSegments(ppxl::Segment const& p_segment, ppxl::Segment const& p_otherSegment) {
+  return AreSamePoints(p_segment.GetA(), p_otherSegment.GetA()) && AreSamePoints(p_segment.GetB(), p_otherSegment.GetB());
+}
+
+bool AreSameLevels(Level const& p_level, Level const& p_otherLevel) {
+  if (p_level.m_linesGoal != p_otherLevel.m_linesGoal || p_level.m_partsGoal != p_otherLevel.m_partsGoal
+    || p_level.m_maxGapToWin != p_otherLevel.m_maxGapToWin || p_level.m_tolerance != p_otherLevel.m_tolerance
+    || p_level.m_starsCount != p_otherLevel.m_starsCount
+    || p_level.m_polygonsList.size() != p_otherLevel.m_polygonsList.size()
+    || p_level.m_tapesList.size() != p_otherLevel.m_tapesList.size()
+    || p_level.m_oneWaysList.size() != p_otherLevel.m_oneWaysList.size()
+    || p_level.m_mirrorsList.size() != p_otherLevel.m_mirrorsList.size()
+    || p_level.m_portalsList.size() != p_otherLevel.m_portalsList.size()) {
+    return false;
+  }
+
+  for (int k = 0; k < p_level.m_polygonsList.size(); ++k) {
+    auto const& vertices = p_level.m_polygonsList.at(k).GetVertices();
+    auto const& otherVertices = p_otherLevel.m_polygonsList.at(k).GetVertices();
+    if (vertices.size() != otherVertices.size()
+      || !std::equal(vertices.cbegin(), vertices.cend(), otherVertices.cbegin(), AreSamePoints)) {
+      return false;
+    }
+  }
+  for (int k = 0; k < p_level.m_tapesList.size(); ++k) {
+    auto const& tape = p_level.m_tapesList.at(k);
+    auto const& otherTape = p_otherLevel.m_tapesList.at(k);
+    if (tape.GetXmin() != otherTape.GetXmin() || tape.GetYmin() != otherTape.GetYmin()
+      || tape.GetW() != otherTape.GetW() || tape.GetH() != otherTape.GetH()) {
+      return false;
+    }
+  }
+  for (int k = 0; k < p_level.m_oneWaysList.size(); ++k) {
+    if (!AreSameSegments(p_level.m_oneWaysList.at(k).GetLine(), p_otherLevel.m_oneWaysList.at(k).GetLine())) {
+      return false;
+    }
+  }
+  for (int k = 0; k < p_level.m_mirrorsList.size(); ++k) {
+    if (!AreSameSegments(p_level.m_mirrorsList.at(k).GetLine(), p_otherLevel.m_mirrorsList.at(k).GetLine())) {
+      return false;
+    }
+  }
+  for (int k = 0; k < p_level.m_portalsList.size(); ++k) {
+    auto const& portal = p_level.m_portalsList.at(k);
+    auto const& otherPortal = p_otherLevel.m_portalsList.at(k);
+    if (!AreSameSegments(portal.GetIn(), otherPortal.GetIn()) || !AreSameSegments(portal.GetOut(), otherPortal.GetOut())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// .ppxl -> .ppxlb -> .ppxl, in both binary modes: every level must come back exactly as it was read
+QStringList FindRoundTripMismatches(QString const& p_worldsDir, QString const& p_tempDir, int& p_levelsCount) {
+  QStringList mismatchesList;
+  QDir worldsDir(p_worldsDir);
+  QDir tempDir(p_tempDir);
+  p_levelsCount = 0;
+  for (auto const& fileName: worldsDir.entryList(QStringList() << "*.ppxl", QDir::Files, QDir::Name)) {
+    ++p_levelsCount;
+    Level level = Parser(worldsDir.filePath(fileName)).GetLevel();
+    for (bool compact: {false, true}) {
+      QString binaryFileName = tempDir.filePath(QFileInfo(fileName).completeBaseName() + "." + BinaryLevel::Suffix);
+      QString xmlFileName = tempDir.filePath(fileName);
+      Level binaryLevel;
+      Level xmlLevel;
+      bool sameLevels = BinaryLevel::Write(level, binaryFileName, compact)
+        && BinaryLevel::Read(binaryFileName, binaryLevel)
+        && AreSameLevels(level, binaryLevel)
+        && Serializer::WriteLevel(binaryLevel, xmlFileName);
+      if (sameLevels) {
+        xmlLevel = Parser(xmlFileName).GetLevel();
+      }
+      if (!sameLevels || !AreSameLevels(level, xmlLevel)) {
+        mismatchesList << fileName + (compact ? " (compact)" : "");
+      }
+    }
+  }
+
+  return mismatchesList;
+}
+
+}
+
+// Loads synthetic levels of growing size and prints, as JSON, how long Parser takes per element:
+// the figure stays flat while loading is linear. Each level is also loaded from its .ppxlb conversion,
+// and saved back with Serializer. Finally, the levels of the worlds directory go through a .ppxlb
+// and back to .ppxl; the benchmark exits with 2 when one of them changed on the way.
+int main(int argc, char* argv[]) {
+  int maxElementsCount = argc > 1 ? QString(argv[1]).toInt() : 10000;
+  int repeatCount = argc > 2 ? QString(argv[2]).toInt() : 5;
+  QString worldsDir = argc > 3 ? QString(argv[3]) : QString("worlds");
+
+  QTemporaryDir tempDir;
+  if (!tempDir.isValid()) {
+    std::cerr << "Cannot create a temporary directory" << std::endl;
+    return 1;
+  }
+
+  std::vector<int> elementsCounts;
+  for (int elementsCount = maxElementsCount; elementsCount >= 100; elementsCount /= 2) {
+    elementsCounts.insert(elementsCounts.begin(), elementsCount);
+  }
+
+  std::cout << "{\n  \"levels\": [\n";
+  for (unsigned int k = 0; k < elementsCounts.size(); ++k) {
+    int elementsCount = elementsCounts[k];
+    QString fileName = tempDir.filePath(QString("synthetic_%1.ppxl").arg(elementsCount));
+    WriteSyntheticLevel(fileName, elementsCount, 2018 + k);
+
+    QString binaryFileName = tempDir.filePath(QString("synthetic_%1.%2").arg(elementsCount).arg(BinaryLevel::Suffix));
+    Level level = Parser(fileName).GetLevel();
+    BinaryLevel::Write(level, binaryFileName);
+
+    int loadedCount = 0;
+    double median = MedianLoadingTime(fileName, repeatCount, loadedCount);
+    int binaryLoadedCount = 0;
+    double binaryMedian = MedianLoadingTime(binaryFileName, repeatCount, binaryLoadedCount);
+    double saveMedian = MedianSavingTime(level, tempDir.filePath(QString("saved_%1.ppxl").arg(elementsCount)), repeatCount);
+
+    std::cout << "    {\"polygons\": " << elementsCount
+              << ", \"objects\": " << elementsCount
+              << ", \"loaded\": " << loadedCount
+              << ", \"median_ms\": " << median
+              << ", \"us_per_element\": " << 1000. * median / (2*elementsCount)
+              << ", \"binary_loaded\": " << binaryLoadedCount
+              << ", \"binary_median_ms\": " << binaryMedian
+              << ", \"binary_us_per_element\": " << 1000. * binaryMedian / (2*elementsCount)
+              << ", \"save_median_ms\": " << saveMedian
+              << ", \"save_us_per_element\": " << 1000. * saveMedian / (2*elementsCount)
+              << ", \"file_bytes\": " << QFileInfo(fileName).size()
+              << "}" << (k+1 < elementsCounts.size() ? "," : "") << "\n";
+  }
+  std::cout << "  ],\n";
+
+  int levelsCount = 0;
+  QStringList mismatchesList = FindRoundTripMismatches(worldsDir, tempDir.path(), levelsCount);
+  std::cout << "  \"round_trip\": {\"levels\": " << levelsCount << ", \"mismatches\": [";
+  for (int k = 0; k < mismatchesList.size(); ++k) {
+    std::cout << (k > 0 ? ", " : "") << "\"" << mismatchesList.at(k).toStdString() << "\"";
+  }
+  std::cout << "]}\n}" << std::endl;
+
+  return mismatchesList.isEmpty() ? 0 : 2;
+}
@@ -0,0 +1,33 @@
+#-------------------------------------------------
+#
+# Headless level I/O benchmark: writes synthetic levels of growing size
+# and prints Parser's loading and Serializer's saving times per element
+# as JSON, then checks that the levels of worlds/ survive a .ppxl ->
+# .ppxlb -> .ppxl round trip unchanged.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = ParserBenchmark
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Geometry and slicing engine, built by Core/ppxl-core.pro
+include(../Core/ppxl-core.pri)
+
+SOURCES += \
+    ParserBenchmark.cxx \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.cxx \
+    $$PWD/../Parser/Parser.cxx \
+    $$PWD/../Parser/Serializer.cxx
+
+HEADERS += \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.hxx \
+    $$PWD/../Parser/Level.hxx \
+    $$PWD/../Parser/Parser.hxx \
+    $$PWD/../Parser/Serializer.hxx
@@ -0,0 +1,570 @@
+#include "Benchmark/LegacyPoint.hxx"
+#include "Benchmark/LegacySlicer.hxx"
+#include "Core/Geometry/Polygon.hxx"
+#include "Core/Geometry/Predicates.hxx"
+#include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/Vector.hxx"
+#include "Core/Slicer.hxx"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace {
+
+void PrintUsage() {
+  std::cerr << "Usage: PolygonBenchmark [--polygons COUNT] [--repeat COUNT] [--seed SEED]" << std::endl
+            << "Times Polygon::ComputeCrossingEdges against the all-pairs edge test on generated polygons," << std::endl
+            << "then compares their crossing edges on COUNT small random polygons." << std::endl
+            << "Also compares Segment::ComputeIntersections, vectorized, with the scalar ComputeIntersection" << std::endl
+            << "on COUNT rings built around the cutting line, and Slicer::ComputeNewPolygonList with the slicing" << std::endl
+            << "it replaced on COUNT polygons, and times point in polygon tests against the former angle sum" << std::endl
+            << "and vertex copies against the former Point layout. Finally times the exact predicates, and counts" << std::endl
+            << "the nearly aligned points whose side depends on the order of the segment's bounds." << std::endl
+            << "Exits with 2 when they disagree." << std::endl;
+}
+
+// The test IsGoodPolygon used to run on every pair of edges
+std::vector<ppxl::Polygon::EdgesPair> ComputeCrossingEdgesBruteForce(ppxl::Polygon const& p_polygon) {
+  auto const& vertices = p_polygon.GetVertices();
+  auto verticesCount = static_cast<unsigned int>(vertices.size());
+  std::vector<ppxl::Polygon::EdgesPair> crossingEdges;
+  for (unsigned int k = 0; k < verticesCount; ++k) {
+    auto const& A = vertices[k];
+    auto const& B = vertices[(k+1)%verticesCount];
+    for (unsigned int i = k+2; i < verticesCount; ++i) {
+      if (k == 0 && i == verticesCount-1) {
+        continue;
+      }
+      auto const& C = vertices[i];
+      auto const& D = vertices[(i+1)%verticesCount];
+      if (ppxl::Segment::ComputeIntersection(A.GetX(), A.GetY(), B.GetX(), B.GetY(), C.GetX(), C.GetY(), D.GetX(), D.GetY()) == ppxl::Segment::Regular) {
+        crossingEdges.emplace_back(k, i);
+      }
+    }
+  }
+
+  return crossingEdges;
+}
+
+// The test Polygon::IsPointInside used to run: the angles under which P sees the edges add up
+// to 2Pi inside the polygon and to 0 outside
+bool IsPointInsideAngleSum(ppxl::Polygon const& p_polygon, ppxl::Point const& P) {
+  auto const& vertices = p_polygon.GetVertices();
+  auto verticesCount = vertices.size();
+  double theta = 0.;
+  for (unsigned int k = 0; k < verticesCount; ++k) {
+    ppxl::Vector vPA(vertices[k] - P);
+    ppxl::Vector vPB(vertices[(k+1)%verticesCount] - P);
+    theta += ppxl::Vector::Angle(vPA, vPB);
+  }
+
+  return static_cast<int>(std::abs(theta)) == 6;
+}
+
+// Side of P from (BA), given its side from (AB)
+ppxl::Segment::Side SwapBounds(ppxl::Segment::Side p_side) {
+  switch (p_side) {
+  case ppxl::Segment::OnLeft:
+    return ppxl::Segment::OnRight;
+  case ppxl::Segment::OnRight:
+    return ppxl::Segment::OnLeft;
+  case ppxl::Segment::IsBoundA:
+    return ppxl::Segment::IsBoundB;
+  case ppxl::Segment::IsBoundB:
+    return ppxl::Segment::IsBoundA;
+  default:
+    return p_side;
+  }
+}
+
+// Whether A, B and P are aligned, or P is on the left or the right of (AB)
+int Orientation(ppxl::Segment::Side p_side) {
+  switch (p_side) {
+  case ppxl::Segment::OnLeft:
+    return 1;
+  case ppxl::Segment::OnRight:
+    return -1;
+  default:
+    return 0;
+  }
+}
+
+// Points nearly on (AB), which has pixel bounds: swapping A and B, or rotating A, B and P, must
+// not change which side P is on. Returns how many points break that.
+unsigned int CountInconsistentSides(std::mt19937& p_generator, unsigned int p_pointsCount) {
+  std::uniform_int_distribution<int> pixelDistribution(0, 1000);
+  std::uniform_real_distribution<double> parameterDistribution(-1., 2.);
+  std::uniform_int_distribution<int> ulpsDistribution(-8, 8);
+  unsigned int inconsistentCount = 0;
+  for (unsigned int k = 0; k < p_pointsCount; ++k) {
+    double ax = pixelDistribution(p_generator);
+    double ay = pixelDistribution(p_generator);
+    double bx = pixelDistribution(p_generator);
+    double by = pixelDistribution(p_generator);
+    double t = parameterDistribution(p_generator);
+    double px = ax + t*(bx - ax);
+    double py = ay + t*(by - ay) + ulpsDistribution(p_generator)*std::numeric_limits<double>::epsilon()*std::max(1., std::abs(ay));
+
+    auto side = ppxl::Segment::Location(ax, ay, bx, by, px, py);
+    bool consistent = SwapBounds(ppxl::Segment::Location(bx, by, ax, ay, px, py)) == side
+      && Orientation(ppxl::Segment::Location(bx, by, px, py, ax, ay)) == Orientation(side)
+      && Orientation(ppxl::Segment::Location(px, py, ax, ay, bx, by)) == Orientation(side);
+    inconsistentCount += consistent ? 0 : 1;
+  }
+
+  return inconsistentCount;
+}
+
+// Star shaped polygon around (500, 500): simple, unless some of its vertices are swapped
+ppxl::Polygon GeneratePolygon(std::mt19937& p_generator, unsigned int p_verticesCount, bool p_onGrid, unsigned int p_swapsCount) {
+  std::uniform_real_distribution<double> angleDistribution(0., 2.*M_PI);
+  std::uniform_real_distribution<double> radiusDistribution(100., 400.);
+  std::vector<double> angles(p_verticesCount);
+  for (auto& angle: angles) {
+    angle = angleDistribution(p_generator);
+  }
+  std::sort(angles.begin(), angles.end());
+
+  std::vector<ppxl::Point> vertices;
+  for (auto angle: angles) {
+    double radius = radiusDistribution(p_generator);
+    double x = 500. + radius*std::cos(angle);
+    double y = 500. + radius*std::sin(angle);
+    // Grid coordinates give the colinear and touching edges floats hardly ever do
+    if (p_onGrid) {
+      x = 10.*std::round(x/10.);
+      y = 10.*std::round(y/10.);
+    }
+    vertices.emplace_back(x, y);
+  }
+  for (unsigned int k = 0; k < p_swapsCount; ++k) {
+    std::swap(vertices[p_generator()%p_verticesCount], vertices[p_generator()%p_verticesCount]);
+  }
+
+  return ppxl::Polygon(vertices);
+}
+
+// Ring of p_verticesCount vertices made to stress the vectorized tolerances against [PQ]: vertices
+// on (PQ), a few ulps away from it, on P or Q, repeated, or anywhere
+void GenerateRing(std::mt19937& p_generator, double p_px, double p_py, double p_qx, double p_qy,
+  unsigned int p_verticesCount, std::vector<double>& p_ringX, std::vector<double>& p_ringY) {
+
+  std::uniform_real_distribution<double> coordinateDistribution(0., 1000.);
+  std::uniform_real_distribution<double> parameterDistribution(-0.5, 1.5);
+  std::uniform_int_distribution<int> ulpsDistribution(-4, 4);
+  p_ringX.clear();
+  p_ringY.clear();
+  for (unsigned int k = 0; k < p_verticesCount; ++k) {
+    double x = coordinateDistribution(p_generator);
+    double y = coordinateDistribution(p_generator);
+    double t = parameterDistribution(p_generator);
+    switch (p_generator()%6) {
+    case 0:
+      x = p_px + t*(p_qx - p_px);
+      y = p_py + t*(p_qy - p_py);
+      break;
+    case 1:
+      x = p_px + t*(p_qx - p_px);
+      y = p_py + t*(p_qy - p_py) + ulpsDistribution(p_generator)*DBL_EPSILON*std::max(1., std::abs(p_py));
+      break;
+    case 2:
+      x = p_generator()%2 == 0 ? p_px : p_qx;
+      y = x == p_px ? p_py : p_qy;
+      break;
+    case 3:
+      if (k > 0) {
+        x = p_ringX.back();
+        y = p_ringY.back();
+      }
+      break;
+    default:
+      break;
+    }
+    p_ringX.push_back(x);
+    p_ringY.push_back(y);
+  }
+}
+
+// Edges where Segment::ComputeIntersections does not give what the scalar ComputeIntersection gives
+unsigned int CountBatchMismatches(double p_px, double p_py, double p_qx, double p_qy,
+  std::vector<double> const& p_ringX, std::vector<double> const& p_ringY) {
+
+  auto count = static_cast<unsigned int>(p_ringX.size());
+  std::vector<ppxl::Segment::Intersection> intersections(count);
+  ppxl::Segment::ComputeIntersections(p_px, p_py, p_qx, p_qy, p_ringX.data(), p_ringY.data(), count, intersections.data());
+  unsigned int mismatchesCount = 0;
+  for (unsigned int k = 0; k < count; ++k) {
+    auto next = (k+1)%count;
+    auto intersection = ppxl::Segment::ComputeIntersection(p_ringX[k], p_ringY[k], p_ringX[next], p_ringY[next], p_px, p_py, p_qx, p_qy);
+    if (intersections[k] != intersection) {
+      ++mismatchesCount;
+    }
+  }
+
+  return mismatchesCount;
+}
+
+// Comb of p_teethCount teeth pointing up from y = 100: a horizontal line at y = 500 cuts all of them
+ppxl::Polygon GenerateComb(unsigned int p_teethCount) {
+  std::vector<ppxl::Point> vertices;
+  double width = 1000./p_teethCount;
+  vertices.emplace_back(0., 0.);
+  vertices.emplace_back(1000., 0.);
+  for (unsigned int k = p_teethCount; k > 0; --k) {
+    double x = k*width;
+    vertices.emplace_back(x, 1000.);
+    vertices.emplace_back(x - width/2., 1000.);
+    vertices.emplace_back(x - width/2., 100.);
+    vertices.emplace_back(x - width, 100.);
+  }
+  vertices.pop_back();
+  vertices.back() = ppxl::Point(0., 1000.);
+
+  return ppxl::Polygon(vertices);
+}
+
+// Across the board, through one of the polygon's vertices a third of the time
+ppxl::Segment GenerateLine(std::mt19937& p_generator, ppxl::Polygon const& p_polygon, bool p_onGrid) {
+  std::uniform_real_distribution<double> coordinateDistribution(0., 1000.);
+  double px = coordinateDistribution(p_generator);
+  double py = coordinateDistribution(p_generator);
+  double qx = coordinateDistribution(p_generator);
+  double qy = coordinateDistribution(p_generator);
+  if (p_onGrid) {
+    px = 10.*std::round(px/10.);
+    py = 10.*std::round(py/10.);
+    qx = 10.*std::round(qx/10.);
+    qy = 10.*std::round(qy/10.);
+  }
+  if (p_generator()%3 == 0) {
+    auto const& vertices = p_polygon.GetVertices();
+    auto const& vertex = vertices[p_generator()%vertices.size()];
+    qx = 2.*vertex.GetX() - px;
+    qy = 2.*vertex.GetY() - py;
+  }
+
+  return ppxl::Segment(ppxl::Point(px, py), ppxl::Point(qx, qy));
+}
+
+// Point's operator== has a tolerance, the pieces must be the very same
+bool AreSamePieces(std::vector<ppxl::Polygon> const& p_pieces, std::vector<ppxl::Polygon> const& p_otherPieces) {
+  if (p_pieces.size() != p_otherPieces.size()) {
+    return false;
+  }
+  for (unsigned int k = 0; k < p_pieces.size(); ++k) {
+    auto const& vertices = p_pieces[k].GetVertices();
+    auto const& otherVertices = p_otherPieces[k].GetVertices();
+    if (vertices.size() != otherVertices.size()
+      || !std::equal(vertices.cbegin(), vertices.cend(), otherVertices.cbegin(), [](ppxl::Point const& p_point, ppxl::Point const& p_otherPoint) {
+        return p_point.GetX() == p_otherPoint.GetX() && p_point.GetY() == p_otherPoint.GetY();
+      })) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template<typename Function>
+double MeasureMilliseconds(Function p_function, unsigned int p_repeatCount) {
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int k = 0; k < p_repeatCount; ++k) {
+    p_function();
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()/p_repeatCount;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int polygonsCount = 20000;
+  unsigned int repeatCount = 5;
+  unsigned int seed = 2018;
+
+  for (int k = 1; k < argc; ++k) {
+    std::string argument(argv[k]);
+    bool hasValue = k+1 < argc;
+    if (argument == "--polygons" && hasValue) {
+      polygonsCount = static_cast<unsigned int>(std::stoul(argv[++k]));
+    } else if (argument == "--repeat" && hasValue) {
+      repeatCount = static_cast<unsigned int>(std::stoul(argv[++k]));
+    } else if (argument == "--seed" && hasValue) {
+      seed = static_cast<unsigned int>(std::stoul(argv[++k]));
+    } else {
+      PrintUsage();
+      return 1;
+    }
+  }
+  if (repeatCount == 0) {
+    PrintUsage();
+    return 1;
+  }
+
+  std::mt19937 generator(seed);
+  bool allMatching = true;
+
+  std::cout << "{\n  \"timings\": [\n";
+  std::vector<unsigned int> verticesCounts = {100, 1000, 10000};
+  for (unsigned int k = 0; k < 2*verticesCounts.size(); ++k) {
+    unsigned int verticesCount = verticesCounts[k/2];
+    unsigned int swapsCount = k%2 == 0 ? 0 : 3;
+    ppxl::Polygon polygon = GeneratePolygon(generator, verticesCount, false, swapsCount);
+    polygon.BuildCaches();
+
+    std::vector<ppxl::Polygon::EdgesPair> sweepCrossingEdges;
+    double sweepMilliseconds = MeasureMilliseconds([&]() { sweepCrossingEdges = polygon.ComputeCrossingEdges(); }, repeatCount);
+    std::vector<ppxl::Polygon::EdgesPair> crossingEdges;
+    double bruteForceMilliseconds = MeasureMilliseconds([&]() { crossingEdges = ComputeCrossingEdgesBruteForce(polygon); }, 1);
+    allMatching = allMatching && sweepCrossingEdges == crossingEdges;
+
+    std::cout << "    {\"vertices\": " << verticesCount
+              << ", \"swaps\": " << swapsCount
+              << ", \"good\": " << (polygon.IsGoodPolygon() ? "true" : "false")
+              << ", \"crossing_edges\": " << crossingEdges.size()
+              << ", \"sweep_ms\": " << sweepMilliseconds
+              << ", \"brute_force_ms\": " << bruteForceMilliseconds
+              << "}" << (k+1 < 2*verticesCounts.size() ? "," : "") << "\n";
+  }
+  std::cout << "  ],\n";
+
+  unsigned int crossingPolygonsCount = 0;
+  unsigned int mismatchesCount = 0;
+  for (unsigned int k = 0; k < polygonsCount; ++k) {
+    unsigned int verticesCount = 3 + generator()%30;
+    bool onGrid = generator()%2 == 0;
+    unsigned int swapsCount = generator()%3;
+    ppxl::Polygon polygon = GeneratePolygon(generator, verticesCount, onGrid, swapsCount);
+    auto crossingEdges = ComputeCrossingEdgesBruteForce(polygon);
+    if (!crossingEdges.empty()) {
+      ++crossingPolygonsCount;
+    }
+    if (polygon.ComputeCrossingEdges() != crossingEdges) {
+      ++mismatchesCount;
+    }
+  }
+  allMatching = allMatching && mismatchesCount == 0;
+
+  std::cout << "  \"differential\": {\"polygons\": " << polygonsCount
+            << ", \"crossing_polygons\": " << crossingPolygonsCount
+            << ", \"mismatches\": " << mismatchesCount << "},\n";
+
+  // Grid lines half of the time, so that vertices land exactly on them
+  std::uniform_real_distribution<double> coordinateDistribution(0., 1000.);
+  std::vector<double> ringX;
+  std::vector<double> ringY;
+  unsigned int edgesCount = 0;
+  unsigned int batchMismatchesCount = 0;
+  for (unsigned int k = 0; k < polygonsCount; ++k) {
+    double px = coordinateDistribution(generator);
+    double py = coordinateDistribution(generator);
+    double qx = coordinateDistribution(generator);
+    double qy = coordinateDistribution(generator);
+    if (k%2 == 0) {
+      px = std::round(px);
+      py = std::round(py);
+      qx = std::round(qx);
+      qy = std::round(qy);
+    }
+    GenerateRing(generator, px, py, qx, qy, 3 + generator()%30, ringX, ringY);
+    edgesCount += static_cast<unsigned int>(ringX.size());
+    batchMismatchesCount += CountBatchMismatches(px, py, qx, qy, ringX, ringY);
+  }
+  allMatching = allMatching && batchMismatchesCount == 0;
+
+  ppxl::Polygon bigPolygon = GeneratePolygon(generator, 10000, false, 0);
+  std::vector<double> bigRingX;
+  std::vector<double> bigRingY;
+  for (auto const& vertex: bigPolygon.GetVertices()) {
+    bigRingX.push_back(vertex.GetX());
+    bigRingY.push_back(vertex.GetY());
+  }
+  auto bigCount = static_cast<unsigned int>(bigRingX.size());
+  std::vector<ppxl::Segment::Intersection> intersections(bigCount);
+  double batchMilliseconds = MeasureMilliseconds([&]() {
+    ppxl::Segment::ComputeIntersections(0., 0., 1000., 1000., bigRingX.data(), bigRingY.data(), bigCount, intersections.data());
+  }, repeatCount);
+  double scalarMilliseconds = MeasureMilliseconds([&]() {
+    for (unsigned int k = 0; k < bigCount; ++k) {
+      auto next = (k+1)%bigCount;
+      intersections[k] = ppxl::Segment::ComputeIntersection(bigRingX[k], bigRingY[k], bigRingX[next], bigRingY[next], 0., 0., 1000., 1000.);
+    }
+  }, repeatCount);
+
+  std::cout << "  \"batch_intersections\": {\"rings\": " << polygonsCount
+            << ", \"edges\": " << edgesCount
+            << ", \"mismatches\": " << batchMismatchesCount
+            << ", \"batch_ms\": " << batchMilliseconds
+            << ", \"scalar_ms\": " << scalarMilliseconds << "},\n";
+
+  // Points spread over the polygons, inside and outside
+  std::cout << "  \"point_inside\": [\n";
+  std::uniform_real_distribution<double> boardDistribution(100., 900.);
+  std::vector<ppxl::Point> points;
+  for (unsigned int k = 0; k < 1000; ++k) {
+    points.emplace_back(boardDistribution(generator), boardDistribution(generator));
+  }
+  std::vector<unsigned int> insideVerticesCounts = {10, 100, 1000, 10000};
+  for (unsigned int k = 0; k < insideVerticesCounts.size(); ++k) {
+    ppxl::Polygon polygon = GeneratePolygon(generator, insideVerticesCounts[k], false, 0);
+    polygon.BuildCaches();
+
+    unsigned int insideCount = 0;
+    double windingMilliseconds = MeasureMilliseconds([&]() {
+      insideCount = 0;
+      for (auto const& point: points) {
+        insideCount += polygon.IsPointInside(point) ? 1 : 0;
+      }
+    }, repeatCount);
+    std::vector<bool> batchInside;
+    double batchMilliseconds = MeasureMilliseconds([&]() { batchInside = polygon.ArePointsInside(points); }, repeatCount);
+    std::vector<bool> angleSumInside(points.size());
+    double angleSumMilliseconds = MeasureMilliseconds([&]() {
+      for (unsigned int i = 0; i < points.size(); ++i) {
+        angleSumInside[i] = IsPointInsideAngleSum(polygon, points[i]);
+      }
+    }, repeatCount);
+    unsigned int disagreementsCount = 0;
+    for (unsigned int i = 0; i < points.size(); ++i) {
+      disagreementsCount += (batchInside[i] != angleSumInside[i] || batchInside[i] != polygon.IsPointInside(points[i])) ? 1 : 0;
+    }
+
+    std::cout << "    {\"vertices\": " << insideVerticesCounts[k]
+              << ", \"points\": " << points.size()
+              << ", \"inside\": " << insideCount
+              << ", \"disagreements\": " << disagreementsCount
+              << ", \"winding_us_per_point\": " << 1000.*windingMilliseconds/points.size()
+              << ", \"batch_us_per_point\": " << 1000.*batchMilliseconds/points.size()
+              << ", \"angle_sum_us_per_point\": " << 1000.*angleSumMilliseconds/points.size()
+              << "}" << (k+1 < insideVerticesCounts.size() ? "," : "") << "\n";
+  }
+  std::cout << "  ],\n";
+
+  // The slicer copies vertices into its pool, then into the new polygons
+  std::vector<ppxl::Point> vertices(1000000);
+  std::vector<LegacyPoint> legacyVertices(vertices.size());
+  for (unsigned int k = 0; k < vertices.size(); ++k) {
+    vertices[k] = ppxl::Point(boardDistribution(generator), boardDistribution(generator));
+    legacyVertices[k] = LegacyPoint(vertices[k].GetX(), vertices[k].GetY());
+  }
+  std::vector<ppxl::Point> verticesCopy;
+  double copyMilliseconds = MeasureMilliseconds([&]() { verticesCopy = vertices; }, repeatCount);
+  std::vector<LegacyPoint> legacyVerticesCopy;
+  double legacyCopyMilliseconds = MeasureMilliseconds([&]() { legacyVerticesCopy = legacyVertices; }, repeatCount);
+  std::vector<ppxl::Point> vertexPool;
+  double poolMilliseconds = MeasureMilliseconds([&]() {
+    vertexPool.clear();
+    vertexPool.reserve(vertices.size());
+    for (auto const& vertex: vertices) {
+      vertexPool.push_back(vertex);
+    }
+  }, repeatCount);
+  std::vector<LegacyPoint> legacyVertexPool;
+  double legacyPoolMilliseconds = MeasureMilliseconds([&]() {
+    legacyVertexPool.clear();
+    legacyVertexPool.reserve(legacyVertices.size());
+    for (auto const& vertex: legacyVertices) {
+      legacyVertexPool.push_back(vertex);
+    }
+  }, repeatCount);
+
+  std::cout << "  \"layout\": {\"point_bytes\": " << sizeof(ppxl::Point)
+            << ", \"legacy_point_bytes\": " << sizeof(LegacyPoint)
+            << ", \"segment_bytes\": " << sizeof(ppxl::Segment)
+            << ", \"legacy_segment_bytes\": " << sizeof(LegacySegment)
+            << ", \"vertices\": " << vertices.size()
+            << ", \"copy_ms\": " << copyMilliseconds
+            << ", \"legacy_copy_ms\": " << legacyCopyMilliseconds
+            << ", \"pool_ms\": " << poolMilliseconds
+            << ", \"legacy_pool_ms\": " << legacyPoolMilliseconds << "},\n";
+
+  // Slicing a comb along its teeth makes as many intersections as vertices
+  std::cout << "  \"slicing\": [\n";
+  std::vector<unsigned int> teethCounts = {10, 100, 1000};
+  for (unsigned int k = 0; k < teethCounts.size(); ++k) {
+    ppxl::Polygon comb = GenerateComb(teethCounts[k]);
+    ppxl::Segment line(ppxl::Point(-1., 500.), ppxl::Point(1001., 500.));
+    // Small enough for the teeth to stay above Slicer's 0.1% threshold
+    double orientedAreaTotal = comb.OrientedArea()/teethCounts[k];
+    Slicer slicer;
+    slicer.SetOrientedAreaTotal(orientedAreaTotal);
+    std::vector<ppxl::Polygon> pieces;
+    double slicerMilliseconds = MeasureMilliseconds([&]() {
+      pieces.clear();
+      slicer.ComputeNewPolygonList(pieces, comb, line);
+    }, repeatCount);
+    std::vector<ppxl::Polygon> legacyPieces;
+    double legacyMilliseconds = MeasureMilliseconds([&]() {
+      legacyPieces = LegacySlicer::ComputeNewPolygonList(comb, line, orientedAreaTotal);
+    }, 1);
+    allMatching = allMatching && AreSamePieces(pieces, legacyPieces);
+
+    std::cout << "    {\"vertices\": " << comb.GetVerticesCount()
+              << ", \"pieces\": " << pieces.size()
+              << ", \"slicer_ms\": " << slicerMilliseconds
+              << ", \"legacy_ms\": " << legacyMilliseconds
+              << "}" << (k+1 < teethCounts.size() ? "," : "") << "\n";
+  }
+  std::cout << "  ],\n";
+
+  unsigned int cutPolygonsCount = 0;
+  unsigned int slicingMismatchesCount = 0;
+  for (unsigned int k = 0; k < polygonsCount; ++k) {
+    unsigned int verticesCount = 3 + generator()%30;
+    bool onGrid = generator()%2 == 0;
+    ppxl::Polygon polygon = GeneratePolygon(generator, verticesCount, onGrid, 0);
+    ppxl::Segment line = GenerateLine(generator, polygon, onGrid);
+    Slicer slicer;
+    slicer.SetOrientedAreaTotal(polygon.OrientedArea());
+    std::vector<ppxl::Polygon> pieces;
+    slicer.ComputeNewPolygonList(pieces, polygon, line);
+    if (pieces.size() > 1) {
+      ++cutPolygonsCount;
+    }
+    if (!AreSamePieces(pieces, LegacySlicer::ComputeNewPolygonList(polygon, line, polygon.OrientedArea()))) {
+      ++slicingMismatchesCount;
+    }
+  }
+  allMatching = allMatching && slicingMismatchesCount == 0;
+
+  std::cout << "  \"slicing_differential\": {\"polygons\": " << polygonsCount
+            << ", \"cut_polygons\": " << cutPolygonsCount
+            << ", \"mismatches\": " << slicingMismatchesCount << "},\n";
+
+  // Generic segments hardly ever need the exact fallback: the filtered fast path is what is timed
+  std::vector<double> segmentsCoordinates(8*100000);
+  for (auto& coordinate: segmentsCoordinates) {
+    coordinate = boardDistribution(generator);
+  }
+  auto classifySegments = [&segmentsCoordinates]() {
+    unsigned int regularCount = 0;
+    for (unsigned int k = 0; k < segmentsCoordinates.size(); k += 8) {
+      double const* c = &segmentsCoordinates[k];
+      regularCount += ppxl::Segment::ComputeIntersection(c[0], c[1], c[2], c[3], c[4], c[5], c[6], c[7]) == ppxl::Segment::Regular ? 1 : 0;
+    }
+    return regularCount;
+  };
+  double toleranceMilliseconds = MeasureMilliseconds(classifySegments, repeatCount);
+  unsigned int toleranceInconsistentCount = CountInconsistentSides(generator, polygonsCount);
+  ppxl::Predicates::SetExact(true);
+  double exactMilliseconds = MeasureMilliseconds(classifySegments, repeatCount);
+  unsigned int exactInconsistentCount = CountInconsistentSides(generator, polygonsCount);
+  ppxl::Predicates::SetExact(false);
+  allMatching = allMatching && exactInconsistentCount == 0;
+
+  std::cout << "  \"predicates\": {\"segments\": " << segmentsCoordinates.size()/8
+            << ", \"tolerance_ms\": " << toleranceMilliseconds
+            << ", \"exact_ms\": " << exactMilliseconds
+            << ", \"exact_cost\": " << exactMilliseconds/toleranceMilliseconds
+            << ", \"aligned_points\": " << polygonsCount
+            << ", \"tolerance_inconsistent\": " << toleranceInconsistentCount
+            << ", \"exact_inconsistent\": " << exactInconsistentCount << "}\n";
+  std::cout << "}" << std::endl;
+
+  return allMatching ? 0 : 2;
+}
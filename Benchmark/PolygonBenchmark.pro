@@ -0,0 +1,31 @@
+#-------------------------------------------------
+#
+# Headless polygon benchmark: times the sweep behind Polygon::IsGoodPolygon against
+# the former all-pairs edge test on generated polygons, checks that both
+# find the same crossing edges, checks the vectorized edge classification
+# against the scalar one and the slicer against the slicing it replaced,
+# times point in polygon tests and vertex copies against their former
+# versions, times and checks the exact predicates, and prints the results
+# as JSON.
+#
+#-------------------------------------------------
+
+CONFIG -= qt
+
+TARGET = PolygonBenchmark
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Geometry and slicing engine, built by Core/ppxl-core.pro
+include(../Core/ppxl-core.pri)
+
+SOURCES += \
+    PolygonBenchmark.cxx \
+    LegacyPoint.cxx \
+    LegacySlicer.cxx
+
+HEADERS += \
+    LegacyPoint.hxx \
+    LegacySlicer.hxx
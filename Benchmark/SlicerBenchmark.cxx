@@ -0,0 +1,154 @@
+#include "Benchmark/GestureReplay.hxx"
+#include "Core/Trace.hxx"
+#include "Parser/Parser.hxx"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+void PrintUsage() {
+  std::cerr << "Usage: SlicerBenchmark [--gestures DIR] [--generate COUNT] [--repeat COUNT] [--seed SEED] [--soak SLICES] [--trace]" << std::endl
+            << "                       [--fragments COUNT] [--mirrors COUNT] [LEVEL.ppxl...]" << std::endl
+            << "Replays DIR/<level>.gestures when it exists, COUNT generated cuts otherwise." << std::endl
+            << "Levels default to worlds/*.ppxl." << std::endl
+            << "--soak then slices each level SLICES times and reports the resident set size along the way." << std::endl
+            << "--fragments and --mirrors replace the levels with a synthetic one: COUNT squares on a grid," << std::endl
+            << "and COUNT mirrors scattered over them." << std::endl
+            << "--trace dumps the last traced messages of each level on stderr; categories are compiled in" << std::endl
+            << "with PPXL_TRACE_CATEGORIES, see Core/ppxl-core.pri, and reported as \"trace_categories\"." << std::endl;
+}
+
+std::vector<Object*> GetObjectsList(Parser& p_parser) {
+  std::vector<Object*> objectsList;
+  for (auto const& tape: p_parser.GetTapesList()) {
+    objectsList.push_back(new Tape(tape));
+  }
+  for (auto const& oneWay: p_parser.GetOneWaysList()) {
+    objectsList.push_back(new OneWay(oneWay));
+  }
+  for (auto const& mirror: p_parser.GetMirrorsList()) {
+    objectsList.push_back(new Mirror(mirror));
+  }
+  for (auto const& portal: p_parser.GetPortalsList()) {
+    objectsList.push_back(new Portal(portal));
+  }
+
+  return objectsList;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  QString gesturesDir;
+  unsigned int generatedCount = 50;
+  unsigned int repeatCount = 20;
+  unsigned int seed = 2018;
+  unsigned long soakSlicesCount = 0;
+  unsigned int fragmentsCount = 0;
+  unsigned int mirrorsCount = 0;
+  bool dumpTrace = false;
+  QStringList levelsList;
+
+  for (int k = 1; k < argc; ++k) {
+    QString argument(argv[k]);
+    bool hasValue = k+1 < argc;
+    if (argument == "--gestures" && hasValue) {
+      gesturesDir = argv[++k];
+    } else if (argument == "--generate" && hasValue) {
+      generatedCount = QString(argv[++k]).toUInt();
+    } else if (argument == "--repeat" && hasValue) {
+      repeatCount = QString(argv[++k]).toUInt();
+    } else if (argument == "--seed" && hasValue) {
+      seed = QString(argv[++k]).toUInt();
+    } else if (argument == "--soak" && hasValue) {
+      soakSlicesCount = QString(argv[++k]).toULong();
+    } else if (argument == "--fragments" && hasValue) {
+      fragmentsCount = QString(argv[++k]).toUInt();
+    } else if (argument == "--mirrors" && hasValue) {
+      mirrorsCount = QString(argv[++k]).toUInt();
+    } else if (argument == "--trace") {
+      dumpTrace = true;
+    } else if (argument.startsWith("--")) {
+      PrintUsage();
+      return 1;
+    } else {
+      levelsList << argument;
+    }
+  }
+
+  bool synthetic = fragmentsCount > 0 || mirrorsCount > 0;
+  if (synthetic) {
+    levelsList = QStringList() << QString("synthetic_%1_fragments_%2_mirrors").arg(fragmentsCount).arg(mirrorsCount);
+  } else if (levelsList.isEmpty()) {
+    QDir worldsDir("worlds");
+    for (auto const& fileName: worldsDir.entryList(QStringList() << "*.ppxl", QDir::Files, QDir::Name)) {
+      levelsList << worldsDir.filePath(fileName);
+    }
+  }
+  if (levelsList.isEmpty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  std::cout << "{\n  \"trace_categories\": " << Trace::EnabledCategories << ",\n";
+  std::cout << "  \"levels\": [\n";
+  for (int k = 0; k < levelsList.size(); ++k) {
+    QString const& levelFileName = levelsList.at(k);
+    std::vector<ppxl::Polygon> polygonsList;
+    std::vector<Object*> objectsList;
+    if (synthetic) {
+      polygonsList = GestureReplay::GenerateFragments(std::max(fragmentsCount, 1u));
+      objectsList = GestureReplay::GenerateMirrors(mirrorsCount, seed);
+    } else {
+      Parser parser(levelFileName);
+      for (auto const& polygon: parser.GetPolygonsList()) {
+        polygonsList.push_back(polygon);
+      }
+      objectsList = GetObjectsList(parser);
+    }
+
+    QString levelName = QFileInfo(levelFileName).completeBaseName();
+    std::vector<Gesture> gestures;
+    bool recorded = !gesturesDir.isEmpty()
+      && GestureReplay::ReadGestures(QDir(gesturesDir).filePath(levelName + ".gestures").toStdString(), gestures);
+    if (!recorded) {
+      gestures = GestureReplay::GenerateGestures(polygonsList, generatedCount, 8., seed);
+    }
+
+    GestureReplay replay(polygonsList, objectsList);
+    for (unsigned int repeat = 0; repeat < repeatCount; ++repeat) {
+      replay.Replay(gestures);
+    }
+
+    std::cout << "    {\n";
+    std::cout << "      \"level\": \"" << levelName.toStdString() << "\",\n";
+    std::cout << "      \"objects\": " << objectsList.size() << ",\n";
+    std::cout << "      \"recorded\": " << (recorded ? "true" : "false") << ",\n";
+    replay.WriteJson(std::cout, "      ");
+    if (soakSlicesCount > 0) {
+      GestureReplay soak(polygonsList, objectsList);
+      soak.Soak(gestures, soakSlicesCount, 10);
+      std::cout << ",\n";
+      soak.WriteSoakJson(std::cout, "      ");
+    }
+    std::cout << "\n    }" << (k+1 < levelsList.size() ? "," : "") << "\n";
+
+    if (dumpTrace) {
+      std::cerr << "Trace of " << levelName.toStdString() << ":" << std::endl;
+      Trace::Dump(std::cerr);
+      Trace::Clear();
+    }
+
+    for (auto object: objectsList) {
+      delete object;
+    }
+  }
+  std::cout << "  ]\n}" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,34 @@
+#-------------------------------------------------
+#
+# Headless slicer benchmark: replays cut gestures on levels and prints
+# per-phase latency percentiles and allocation counts as JSON. With --soak,
+# also reports the resident set size over a long run of slices.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = SlicerBenchmark
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Geometry and slicing engine, built by Core/ppxl-core.pro
+include(../Core/ppxl-core.pri)
+
+SOURCES += \
+    SlicerBenchmark.cxx \
+    GestureReplay.cxx \
+    AllocationCounter.cxx \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.cxx \
+    $$PWD/../Parser/Parser.cxx \
+
+HEADERS += \
+    GestureReplay.hxx \
+    AllocationCounter.hxx \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.hxx \
+    $$PWD/../Parser/Level.hxx \
+    $$PWD/../Parser/Parser.hxx
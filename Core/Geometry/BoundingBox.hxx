@@ -0,0 +1,95 @@
+#ifndef BOUNDINGBOX_HXX
+#define BOUNDINGBOX_HXX
+
+#include "Core/Geometry/Point.hxx"
+#include "Core/Geometry/Segment.hxx"
+
+#include <algorithm>
+#include <limits>
+
+namespace ppxl {
+
+// Axis aligned box; the default one is empty and grows with Extend.
+class BoundingBox {
+public:
+  constexpr BoundingBox():
+    m_xMin(std::numeric_limits<double>::infinity()),
+    m_yMin(std::numeric_limits<double>::infinity()),
+    m_xMax(-std::numeric_limits<double>::infinity()),
+    m_yMax(-std::numeric_limits<double>::infinity()) {}
+  constexpr BoundingBox(double p_xMin, double p_yMin, double p_xMax, double p_yMax):
+    m_xMin(p_xMin), m_yMin(p_yMin), m_xMax(p_xMax), m_yMax(p_yMax) {}
+
+  constexpr double GetXMin() const { return m_xMin; }
+  constexpr double GetYMin() const { return m_yMin; }
+  constexpr double GetXMax() const { return m_xMax; }
+  constexpr double GetYMax() const { return m_yMax; }
+  constexpr bool IsEmpty() const { return m_xMin > m_xMax || m_yMin > m_yMax; }
+  constexpr Point GetCenter() const { return Point((m_xMin + m_xMax)/2., (m_yMin + m_yMax)/2.); }
+
+  void Extend(double p_x, double p_y) {
+    m_xMin = std::min(m_xMin, p_x);
+    m_yMin = std::min(m_yMin, p_y);
+    m_xMax = std::max(m_xMax, p_x);
+    m_yMax = std::max(m_yMax, p_y);
+  }
+  void Extend(Point const& p_point) { Extend(p_point.GetX(), p_point.GetY()); }
+  void Extend(BoundingBox const& p_box) {
+    m_xMin = std::min(m_xMin, p_box.m_xMin);
+    m_yMin = std::min(m_yMin, p_box.m_yMin);
+    m_xMax = std::max(m_xMax, p_box.m_xMax);
+    m_yMax = std::max(m_yMax, p_box.m_yMax);
+  }
+
+  static BoundingBox FromSegment(Segment const& p_segment) {
+    BoundingBox box;
+    box.Extend(p_segment.GetA());
+    box.Extend(p_segment.GetB());
+    return box;
+  }
+
+  constexpr BoundingBox Inflated(double p_margin) const {
+    return BoundingBox(m_xMin - p_margin, m_yMin - p_margin, m_xMax + p_margin, m_yMax + p_margin);
+  }
+
+  constexpr bool Intersects(BoundingBox const& p_box) const {
+    return m_xMin <= p_box.m_xMax && p_box.m_xMin <= m_xMax
+        && m_yMin <= p_box.m_yMax && p_box.m_yMin <= m_yMax;
+  }
+
+  // Slab test: clips [AB] against both pairs of sides
+  bool Intersects(Segment const& p_segment) const {
+    double ax = p_segment.GetA().GetX();
+    double ay = p_segment.GetA().GetY();
+    double bx = p_segment.GetB().GetX();
+    double by = p_segment.GetB().GetY();
+
+    double tMin = 0.;
+    double tMax = 1.;
+    auto clip = [&tMin, &tMax](double p_origin, double p_direction, double p_low, double p_high) {
+      if (p_direction == 0.) {
+        return p_low <= p_origin && p_origin <= p_high;
+      }
+      double t1 = (p_low - p_origin)/p_direction;
+      double t2 = (p_high - p_origin)/p_direction;
+      if (t1 > t2) {
+        std::swap(t1, t2);
+      }
+      tMin = std::max(tMin, t1);
+      tMax = std::min(tMax, t2);
+      return tMin <= tMax;
+    };
+
+    return clip(ax, bx - ax, m_xMin, m_xMax) && clip(ay, by - ay, m_yMin, m_yMax);
+  }
+
+private:
+  double m_xMin;
+  double m_yMin;
+  double m_xMax;
+  double m_yMax;
+};
+
+}
+
+#endif
@@ -3,43 +3,43 @@
 
 #include <iostream>
 
-#include <QDebug>
-
 namespace ppxl {
 class Vector;
 
+// Plain value type: trivially copyable, two doubles and nothing else.
 class Point {
 public:
-  Point(double p_x = 0.0, double p_y = 0.0);
+  constexpr Point(double p_x = 0.0, double p_y = 0.0): m_x(p_x), m_y(p_y) {}
   Point(double p_xMin, double p_xMax, double p_yMin, double p_yMax);
-  Point(Point const& p_point);
-  virtual ~Point();
 
-  inline double GetX() const { return m_x; }
-  inline double GetY() const { return m_y; }
+  constexpr double GetX() const { return m_x; }
+  constexpr double GetY() const { return m_y; }
 
-  inline void SetX(double const& p_x) { m_x = p_x; }
-  inline void SetY(double const& p_y) { m_y = p_y; }
+  constexpr void SetX(double const& p_x) { m_x = p_x; }
+  constexpr void SetY(double const& p_y) { m_y = p_y; }
 
-  void Move(double const& p_x = 0.0, double const& p_y = 0.0);
+  constexpr void Move(double const& p_x = 0.0, double const& p_y = 0.0) { m_x += p_x; m_y += p_y; }
 
-  void Symetry();
+  constexpr void Symetry() { double tmp = m_y; m_y = m_x; m_x = tmp; }
 
-  void Homothetie(Point const& p_origin, double p_scale);
+  constexpr void Homothetie(Point const& p_origin, double p_scale) {
+    m_x = p_scale*(m_x - p_origin.m_x) + p_origin.m_x;
+    m_y = p_scale*(m_y - p_origin.m_y) + p_origin.m_y;
+  }
   Point Translate(Vector const& p_vector) const;
   Point& Translated(Vector const& p_vector);
 
-  Point operator/(double const& p_scalar) const;
-  Point& operator/=(double const& p_scalar);
+  constexpr Point operator/(double const& p_scalar) const { return Point(m_x/p_scalar, m_y/p_scalar); }
+  constexpr Point& operator/=(double const& p_scalar) { m_x /= p_scalar; m_y /= p_scalar; return *this; }
 
-  friend Point operator+(Point const& p_point1, Point const& p_point2);
+  friend constexpr Point operator+(Point const& p_point1, Point const& p_point2) {
+    return Point(p_point1.m_x + p_point2.m_x, p_point1.m_y + p_point2.m_y);
+  }
   friend Point operator+(Point const& p_origin, Vector const& p_direction);
-  Point& operator+=(Point const& p_point);
+  constexpr Point& operator+=(Point const& p_point) { m_x += p_point.m_x; m_y += p_point.m_y; return *this; }
 
   friend Vector operator-(Point const& p_point1, Point const& p_point2);
 
-  Point& operator=(Point const& p_point);
-
   friend bool operator==(Point const& p_point1, Point const& p_point2);
   friend bool operator!=(Point const& p_point1, Point const& p_point2);
   friend bool operator<(Point const& p_point1, Point const& p_point2);
@@ -48,12 +48,13 @@ public:
   friend bool operator>=(Point const& p_point1, Point const& p_point2);
 
   static double Distance(Point const& p_point1, Point const& p_point2);
-  static Point Middle(Point const& p_point1, Point const& p_point2);
+  static constexpr Point Middle(Point const& p_point1, Point const& p_point2) {
+    return Point((p_point1.m_x + p_point2.m_x)/2., (p_point1.m_y + p_point2.m_y)/2.);
+  }
 
   static void GetDiscreteEndPoint(Point const& p_startRealPoint, Point const& p_realEndPoint, Point& p_discreteEndPoint);
 
   friend std::ostream& operator<<(std::ostream& p_os, Point const& p_point);
-  friend QDebug operator<<(QDebug p_debug, Point const& p_point);
 
 private:
   double m_x;
@@ -3,20 +3,37 @@
 #include "Core/Geometry/Point.hxx"
 #include "Core/Geometry/Vector.hxx"
 #include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/Predicates.hxx"
+#include "Core/Trace.hxx"
 
 #include <cmath>        // round, abs
 #include <cfloat>       // DBL_EPSILON
 #include <cstring>      // string
 #include <algorithm>    // sort
+#include <iterator>     // next, prev
+#include <limits>       // infinity
+#include <set>          // sweep line
+#include <tuple>        // tie
 #include <iomanip>      // boolalpha
 
 namespace ppxl {
 
 Polygon::Polygon(std::vector<Point> const& p_vertices):
-  m_vertices(p_vertices) {
+  m_vertices(p_vertices),
+  m_edgesCacheValid(false),
+  m_area(0.),
+  m_barycenter(),
+  m_boundingBox(),
+  m_metricsCacheValid(false) {
 }
 
-Polygon::Polygon(int p_xMin, int p_xMax, int p_yMin, int p_yMax, unsigned int p_verticesCount) {
+Polygon::Polygon(int p_xMin, int p_xMax, int p_yMin, int p_yMax, unsigned int p_verticesCount):
+  m_vertices(),
+  m_edgesCacheValid(false),
+  m_area(0.),
+  m_barycenter(),
+  m_boundingBox(),
+  m_metricsCacheValid(false) {
   if (p_verticesCount < 3)
     Polygon();
 
@@ -33,34 +50,34 @@ Polygon::Polygon(int p_xMin, int p_xMax, int p_yMin, int p_yMax, unsigned int p_
   }
 }
 
-Polygon::Polygon(Polygon const& p_polygon):
-  m_vertices(p_polygon.m_vertices) {
-}
-
-Polygon::~Polygon() = default;
-
 void Polygon::SetVertices(std::vector<Point> const& p_vertices) {
   m_vertices = p_vertices;
+  InvalidateCaches();
 }
 
 void Polygon::InsertVertex(Point const& p_vertex, unsigned int p_position) {
   m_vertices.insert(m_vertices.begin()+p_position, p_vertex);
+  InvalidateCaches();
 }
 
 void Polygon::SetVertexAt(Point const& p_vertex, unsigned int p_position) {
   m_vertices[p_position] = p_vertex;
+  InvalidateCaches();
 }
 
 void Polygon::AppendVertex(Point const& p_vertex) {
   m_vertices.push_back(p_vertex);
+  InvalidateCaches();
 }
 
 void Polygon::RemoveVertex(unsigned int p_position) {
   m_vertices.erase(m_vertices.begin()+p_position);
+  InvalidateCaches();
 }
 
 void Polygon::ReplaceVertex(unsigned int p_position, Point const& p_newVertex) {
   m_vertices[p_position] = p_newVertex;
+  InvalidateCaches();
 }
 
 void Polygon::Translate(Vector const& p_direction) {
@@ -76,12 +93,20 @@ void Polygon::Translate(double p_x, double p_y) {
   {
     vertex.Move(p_x, p_y);
   }
+  m_edgesCacheValid = false;
+
+  if (m_metricsCacheValid) {
+    m_barycenter.Move(p_x, p_y);
+    m_boundingBox = BoundingBox(m_boundingBox.GetXMin() + p_x, m_boundingBox.GetYMin() + p_y,
+      m_boundingBox.GetXMax() + p_x, m_boundingBox.GetYMax() + p_y);
+  }
 }
 
 void Polygon::Homothetie(Point const& p_origin, double p_scale) {
   for (auto& vertex: m_vertices) {
     vertex.Homothetie(p_origin, p_scale);
   }
+  InvalidateCaches();
 }
 
 bool Polygon::NewPointIsGood(Point const& p_vertex) const {
@@ -103,22 +128,61 @@ bool Polygon::NewPointIsGood(Point const& p_vertex) const {
 }
 
 bool Polygon::IsPointInside(Point const& P) const {
+  UpdateEdgesCache();
+
   auto countVertices = m_vertices.size();
-  double theta = 0.;
+  double px = P.GetX();
+  double py = P.GetY();
+  int windingNumber = 0;
 
   for (unsigned int k = 0; k < countVertices; k++) {
-    Point A(m_vertices.at(k));
-    Point B(m_vertices.at((k+1)%countVertices));
-    Vector vPA(A - P);
-    Vector vPB(B - P);
-    theta += Vector::Angle(vPA, vPB);
+    auto next = (k+1)%countVertices;
+    if (!AddEdgeWinding(m_edgesX0[k], m_edgesY0[k], m_edgesX0[next], m_edgesY0[next], m_edgesDx[k], m_edgesDy[k], px, py, windingNumber)) {
+      return false;
+    }
+  }
+
+  return windingNumber != 0;
+}
+
+std::vector<bool> Polygon::ArePointsInside(std::vector<Point> const& p_points) const {
+  UpdateEdgesCache();
+
+  // Point by point: the edges arrays stream through the cache, while browsing edges first
+  // would load and store every winding number once per edge
+  std::vector<bool> inside;
+  inside.reserve(p_points.size());
+  for (auto const& point: p_points) {
+    inside.push_back(IsPointInside(point));
   }
 
-  // Methematically, theta can only take two values:
-  // - 0 if point is outside the polygon
-  // - 2Pi if point is inside the polygon
-  // In order to avoid any double comparison, truncate it and compare it to 6 (2Pi ~ 6.28)
-  return static_cast<int>(std::abs(theta)) == 6;
+  return inside;
+}
+
+bool Polygon::AddEdgeWinding(double p_ax, double p_ay, double p_bx, double p_by, double p_dx, double p_dy,
+  double p_px, double p_py, int& p_windingNumber) {
+  // Positive if P is on the left of AB, negative if on the right, null if aligned
+  double cross = Predicates::IsExact()
+    ? Predicates::Orient2d(p_ax, p_ay, p_bx, p_by, p_px, p_py)
+    : p_dx*(p_py - p_ay) - (p_px - p_ax)*p_dy;
+
+  // Points on the boundary are not inside
+  if (cross == 0.
+   && std::min(p_ax, p_bx) <= p_px && p_px <= std::max(p_ax, p_bx)
+   && std::min(p_ay, p_by) <= p_py && p_py <= std::max(p_ay, p_by)) {
+    return false;
+  }
+
+  // Count upward edges having P on their left and downward edges having P on their right
+  if (p_ay <= p_py) {
+    if (p_by > p_py && cross > 0.) {
+      ++p_windingNumber;
+    }
+  } else if (p_by <= p_py && cross < 0.) {
+    --p_windingNumber;
+  }
+
+  return true;
 }
 
 bool Polygon::IsPointNearOneEdge(Point const& M, double p_tolerance) const {
@@ -134,9 +198,15 @@ bool Polygon::IsPointNearOneEdge(Point const& M, double p_tolerance) const {
   return false;
 }
 
-bool Polygon::IsCrossing(Segment const& p_line) const {
-  auto verticesCount = m_vertices.size();
+void Polygon::ComputeIntersections(Segment const& p_line, std::vector<Segment::Intersection>& p_intersections) const {
+  UpdateEdgesCache();
+  p_intersections.resize(m_vertices.size());
+  Segment::ComputeIntersections(
+    p_line.GetA().GetX(), p_line.GetA().GetY(), p_line.GetB().GetX(), p_line.GetB().GetY(),
+    m_edgesX0.data(), m_edgesY0.data(), static_cast<unsigned int>(m_vertices.size()), p_intersections.data());
+}
 
+bool Polygon::IsCrossing(Segment const& p_line) const {
   int regularCount = 0;
   int fstVertexCount = 0;
   int sndVertexCount = 0;
@@ -144,9 +214,10 @@ bool Polygon::IsCrossing(Segment const& p_line) const {
   int noneCount = 0;
   int otherCount = 0;
 
-  for (unsigned int k = 0; k < verticesCount; k++) {
-    Segment edge(m_vertices.at(k), m_vertices.at((k+1)%verticesCount));
-    Segment::Intersection intersection = edge.ComputeIntersection(p_line);
+  std::vector<Segment::Intersection> intersections;
+  ComputeIntersections(p_line, intersections);
+
+  for (auto intersection: intersections) {
     switch (intersection) {
     case Segment::Regular: {
       regularCount++;
@@ -180,84 +251,254 @@ bool Polygon::IsGoodSegment(Segment const& p_line) const {
 }
 
 bool Polygon::IsGoodPolygon() const {
+  UpdateEdgesCache();
+
   auto countVertices = m_vertices.size();
   for (unsigned int k = 0; k < countVertices; k++) {
-    Point A(m_vertices.at(k));
-    Point B(m_vertices.at((k+1)%countVertices));
-    Point C(m_vertices.at((k+2)%countVertices));
-    if (A == B) {
+    auto kB = (k+1)%countVertices;
+    auto kC = (k+2)%countVertices;
+    double ax = m_edgesX0[k];
+    double ay = m_edgesY0[k];
+    double bx = m_edgesX0[kB];
+    double by = m_edgesY0[kB];
+    double dx = m_edgesDx[k];
+    double dy = m_edgesDy[k];
+    if (std::abs(dx) < DBL_EPSILON && std::abs(dy) < DBL_EPSILON) {
+      PPXL_TRACE(eGeometry, "Polygon::IsGoodPolygon: null edge " << k);
       return false;
     }
 
-    Vector vAB(A, B);
-    Vector vAC(A, C);
-    if (Vector::AreColinear(vAB, vAC)) {
+    // AB and AC are colinear
+    if (Predicates::IsExact()
+      ? Predicates::Orient2d(ax, ay, bx, by, m_edgesX0[kC], m_edgesY0[kC]) == 0.
+      : std::abs(dx*(m_edgesY0[kC] - ay) - dy*(m_edgesX0[kC] - ax)) < 100.*DBL_EPSILON) {
+      PPXL_TRACE(eGeometry, "Polygon::IsGoodPolygon: colinear edges " << k << " and " << kB);
       return false;
     }
+  }
 
-    Segment AB(A, B);
-    for (unsigned int i = 0; i < countVertices; ++i) {
-      if (i == k || (i-1)%countVertices == k || (i+1)%countVertices == k) {
-        continue;
-      }
-      Point C(m_vertices.at(i));
-      Point D(m_vertices.at((i+1)%countVertices));
-      Segment CD(C, D);
-      if (AB.ComputeIntersection(CD) == Segment::Regular) {
-        return false;
-      }
-    }
+  if (HasCrossingEdges()) {
+    PPXL_TRACE(eGeometry, "Polygon::IsGoodPolygon: " << ComputeCrossingEdges().size() << " pairs of crossing edges");
+    return false;
   }
   return true;
 }
 
-double Polygon::OrientedArea() const {
+bool Polygon::AreEdgesCrossing(unsigned int p_edge1, unsigned int p_edge2) const {
   auto countVertices = m_vertices.size();
-  double area = 0.0;
+  auto next1 = (p_edge1+1)%countVertices;
+  auto next2 = (p_edge2+1)%countVertices;
+  // Adjacent edges only share a vertex
+  if (p_edge1 == p_edge2 || next1 == p_edge2 || next2 == p_edge1) {
+    return false;
+  }
+  return Segment::ComputeIntersection(m_edgesX0[p_edge1], m_edgesY0[p_edge1], m_edgesX0[next1], m_edgesY0[next1],
+    m_edgesX0[p_edge2], m_edgesY0[p_edge2], m_edgesX0[next2], m_edgesY0[next2]) == Segment::Regular;
+}
 
-  for (unsigned int k = 0; k < countVertices; k++) {
-    Point A(m_vertices.at(k));
-    Point B(m_vertices.at((k+1)%countVertices));
-    Segment edge(A, B);
+namespace {
+
+// Edges seen from left to right, as the sweep line meets them
+struct SweepEdges {
+  std::vector<double> m_leftX;
+  std::vector<double> m_leftY;
+  std::vector<double> m_rightX;
+  std::vector<double> m_rightY;
+  std::vector<double> m_slopes;
+  double m_sweepX = 0.;
+
+  // Y where the edge crosses the sweep line, exact at its ends
+  double YAt(unsigned int p_edge) const {
+    if (m_sweepX == m_leftX[p_edge]) {
+      return m_leftY[p_edge];
+    } else if (m_sweepX == m_rightX[p_edge]) {
+      return m_rightY[p_edge];
+    }
+    return m_leftY[p_edge] + (m_sweepX - m_leftX[p_edge])*m_slopes[p_edge];
+  }
+};
 
-    area += edge.OrientedArea();
+// Bottom to top along the sweep line, then by slope for edges leaving the same point
+struct SweepOrder {
+  SweepEdges const* m_edges;
+
+  bool operator()(unsigned int p_edge1, unsigned int p_edge2) const {
+    double y1 = m_edges->YAt(p_edge1);
+    double y2 = m_edges->YAt(p_edge2);
+    if (y1 != y2) {
+      return y1 < y2;
+    }
+    double slope1 = m_edges->m_slopes[p_edge1];
+    double slope2 = m_edges->m_slopes[p_edge2];
+    if (slope1 != slope2) {
+      return slope1 < slope2;
+    }
+    return p_edge1 < p_edge2;
   }
+};
 
-  return std::abs(area);
 }
 
-Point Polygon::Barycenter() const {
-  if (m_vertices.size() < 3) {
-    std::cerr << "Error within Polygon::barycenter: polygon has less than 3 vertices." << std::endl;
-    return Point();
+// Shamos-Hoey: the leftmost crossing is between two edges that are neighbours on the sweep line
+// at some point before it, so only neighbours are tested, when they become so. Vertical edges
+// never enter the sweep line: at their x, they are tested against the edges in their y range.
+bool Polygon::HasCrossingEdges() const {
+  UpdateEdgesCache();
+
+  auto countVertices = static_cast<unsigned int>(m_vertices.size());
+  if (countVertices < 4) {
+    return false;
   }
 
-  Point bary;
-  double baryX = 0.;
-  double baryY = 0.;
+  enum EventType {
+    eLeave,
+    eVertical,
+    eEnter
+  };
+  struct Event {
+    double m_x;
+    double m_y;
+    EventType m_type;
+    unsigned int m_edge;
+  };
+
+  SweepEdges edges;
+  edges.m_leftX.resize(countVertices + 1);
+  edges.m_leftY.resize(countVertices + 1);
+  edges.m_rightX.resize(countVertices + 1);
+  edges.m_rightY.resize(countVertices + 1);
+  edges.m_slopes.resize(countVertices + 1);
+  std::vector<Event> events;
+  events.reserve(2*countVertices);
+  for (unsigned int k = 0; k < countVertices; ++k) {
+    auto next = (k+1)%countVertices;
+    double ax = m_edgesX0[k], ay = m_edgesY0[k];
+    double bx = m_edgesX0[next], by = m_edgesY0[next];
+    if (bx < ax || (bx == ax && by < ay)) {
+      std::swap(ax, bx);
+      std::swap(ay, by);
+    }
+    edges.m_leftX[k] = ax;
+    edges.m_leftY[k] = ay;
+    edges.m_rightX[k] = bx;
+    edges.m_rightY[k] = by;
+    if (ax == bx) {
+      events.push_back({ax, ay, eVertical, k});
+    } else {
+      edges.m_slopes[k] = (by - ay)/(bx - ax);
+      events.push_back({ax, ay, eEnter, k});
+      events.push_back({bx, by, eLeave, k});
+    }
+  }
+  std::sort(events.begin(), events.end(), [](Event const& p_event1, Event const& p_event2) {
+    return std::tie(p_event1.m_x, p_event1.m_y, p_event1.m_type, p_event1.m_edge)
+      < std::tie(p_event2.m_x, p_event2.m_y, p_event2.m_type, p_event2.m_edge);
+  });
+
+  // Looking up a vertical edge's range goes through a probe edge, one past the last one
+  unsigned int probe = countVertices;
+  edges.m_slopes[probe] = -std::numeric_limits<double>::infinity();
+
+  using SweepLine = std::set<unsigned int, SweepOrder>;
+  SweepLine sweepLine(SweepOrder{&edges});
+  std::vector<SweepLine::iterator> positions(countVertices, sweepLine.end());
+
+  for (auto const& event: events) {
+    edges.m_sweepX = event.m_x;
+    unsigned int edge = event.m_edge;
+
+    if (event.m_type == eEnter) {
+      auto position = sweepLine.insert(edge).first;
+      positions[edge] = position;
+      if (position != sweepLine.begin() && AreEdgesCrossing(edge, *std::prev(position))) {
+        return true;
+      }
+      auto above = std::next(position);
+      if (above != sweepLine.end() && AreEdgesCrossing(edge, *above)) {
+        return true;
+      }
+    } else if (event.m_type == eLeave) {
+      auto position = positions[edge];
+      auto above = std::next(position);
+      if (position != sweepLine.begin() && above != sweepLine.end() && AreEdgesCrossing(*std::prev(position), *above)) {
+        return true;
+      }
+      sweepLine.erase(position);
+    } else {
+      edges.m_leftX[probe] = edges.m_rightX[probe] = event.m_x;
+      edges.m_leftY[probe] = edges.m_rightY[probe] = edges.m_leftY[edge];
+      for (auto it = sweepLine.lower_bound(probe); it != sweepLine.end() && edges.YAt(*it) <= edges.m_rightY[edge]; ++it) {
+        if (AreEdgesCrossing(edge, *it)) {
+          return true;
+        }
+      }
+    }
+  }
 
-  auto vertexCount = m_vertices.size();
-  for (unsigned int k = 0; k < vertexCount; ++k) {
-    Point const& A = m_vertices.at(k);
-    Point const& B = m_vertices.at((k+1)%vertexCount);
+  return false;
+}
 
-    double ax = A.GetX();
-    double bx = B.GetX();
-    double ay = A.GetY();
-    double by = B.GetY();
+std::vector<Polygon::EdgesPair> Polygon::ComputeCrossingEdges() const {
+  std::vector<EdgesPair> crossingEdges;
+  if (!HasCrossingEdges()) {
+    return crossingEdges;
+  }
 
-    baryX += (ax+bx)*(ax*by - bx*ay);
-    baryY += (ay+by)*(ax*by - bx*ay);
+  // Crossing polygons are the exception, and mostly small ones being edited: edges are tested
+  // against the ones whose boxes meet theirs, found by sorting them along x
+  auto countVertices = static_cast<unsigned int>(m_vertices.size());
+  std::vector<BoundingBox> boxes;
+  std::vector<unsigned int> order;
+  for (unsigned int k = 0; k < countVertices; ++k) {
+    auto next = (k+1)%countVertices;
+    boxes.push_back(BoundingBox::FromSegment(Segment(m_edgesX0[k], m_edgesY0[k], m_edgesX0[next], m_edgesY0[next])));
+    order.push_back(k);
+  }
+  std::sort(order.begin(), order.end(), [&boxes](unsigned int p_edge1, unsigned int p_edge2) {
+    return boxes[p_edge1].GetXMin() < boxes[p_edge2].GetXMin();
+  });
+
+  std::vector<unsigned int> openEdges;
+  for (auto edge: order) {
+    auto const& box = boxes[edge];
+    openEdges.erase(std::remove_if(openEdges.begin(), openEdges.end(), [&boxes, &box](unsigned int p_open) {
+      return boxes[p_open].GetXMax() < box.GetXMin();
+    }), openEdges.end());
+    for (auto other: openEdges) {
+      if (boxes[other].Intersects(box) && AreEdgesCrossing(edge, other)) {
+        crossingEdges.emplace_back(std::min(edge, other), std::max(edge, other));
+      }
+    }
+    openEdges.push_back(edge);
   }
 
-  // take abs other wise barycenter depends on vertex browse direction
-  bary.SetX(std::abs(baryX));
-  bary.SetY(std::abs(baryY));
+  std::sort(crossingEdges.begin(), crossingEdges.end());
+  return crossingEdges;
+}
 
-  /// 6?
-  bary /= (6*OrientedArea());
+double Polygon::OrientedArea() const {
+  UpdateMetricsCache();
+  return m_area;
+}
+
+Point Polygon::Barycenter() const {
+  if (m_vertices.size() < 3) {
+    std::cerr << "Error within Polygon::barycenter: polygon has less than 3 vertices." << std::endl;
+    return Point();
+  }
 
-  return bary;
+  UpdateMetricsCache();
+  return m_barycenter;
+}
+
+BoundingBox Polygon::GetBoundingBox() const {
+  UpdateMetricsCache();
+  return m_boundingBox;
+}
+
+void Polygon::BuildCaches() const {
+  UpdateEdgesCache();
+  UpdateMetricsCache();
 }
 
 double Polygon::ComputeAngleFromPoint(double p_x, double p_y) {
@@ -276,18 +517,70 @@ double Polygon::ComputeAngleFromPoint(double p_x, double p_y) {
   return res;
 }
 
-void Polygon::ComputeBoundingRect(double& p_left, double& p_top, double& p_right, double& p_bottom) const {
-  p_left = std::numeric_limits<double>::infinity();
-  p_top = std::numeric_limits<double>::infinity();
-  p_right = -std::numeric_limits<double>::infinity();
-  p_bottom = -std::numeric_limits<double>::infinity();
+void Polygon::UpdateEdgesCache() const {
+  if (m_edgesCacheValid) {
+    return;
+  }
 
-  for (auto const& vertex: m_vertices) {
-    p_left = std::min(p_left, vertex.GetX());
-    p_top = std::min(p_top, vertex.GetY());
-    p_right = std::max(p_right, vertex.GetX());
-    p_bottom = std::max(p_bottom, vertex.GetY());
+  auto countVertices = m_vertices.size();
+  m_edgesX0.resize(countVertices);
+  m_edgesY0.resize(countVertices);
+  m_edgesDx.resize(countVertices);
+  m_edgesDy.resize(countVertices);
+
+  for (unsigned int k = 0; k < countVertices; k++) {
+    Point const& A = m_vertices[k];
+    Point const& B = m_vertices[(k+1)%countVertices];
+    m_edgesX0[k] = A.GetX();
+    m_edgesY0[k] = A.GetY();
+    m_edgesDx[k] = B.GetX() - A.GetX();
+    m_edgesDy[k] = B.GetY() - A.GetY();
   }
+
+  m_edgesCacheValid = true;
+}
+
+void Polygon::UpdateMetricsCache() const {
+  if (m_metricsCacheValid) {
+    return;
+  }
+
+  auto countVertices = m_vertices.size();
+  double area = 0.;
+  double cross = 0.;
+  double baryX = 0.;
+  double baryY = 0.;
+  BoundingBox box;
+
+  for (unsigned int k = 0; k < countVertices; k++) {
+    Point const& A = m_vertices[k];
+    Point const& B = m_vertices[(k+1)%countVertices];
+    double ax = A.GetX();
+    double ay = A.GetY();
+    double bx = B.GetX();
+    double by = B.GetY();
+
+    area += (bx - ax)*(by + ay)/2.;
+    double edgeCross = ax*by - bx*ay;
+    cross += edgeCross;
+    baryX += (ax + bx)*edgeCross;
+    baryY += (ay + by)*edgeCross;
+    box.Extend(ax, ay);
+  }
+
+  m_area = std::abs(area);
+  // cross is twice the signed area, its sign cancels out the one of the sums whatever the vertices' order
+  m_barycenter = Point(baryX/(3.*cross), baryY/(3.*cross));
+  m_boundingBox = box;
+  m_metricsCacheValid = true;
+}
+
+void Polygon::ComputeBoundingRect(double& p_left, double& p_top, double& p_right, double& p_bottom) const {
+  BoundingBox box = GetBoundingBox();
+  p_left = box.GetXMin();
+  p_top = box.GetYMin();
+  p_right = box.GetXMax();
+  p_bottom = box.GetYMax();
 }
 
 bool operator==(Polygon const& p_polygon1, Polygon const& p_polygon2) {
@@ -336,15 +629,4 @@ std::ostream& operator<<(std::ostream& p_os, Polygon const& p_polygon) {
   return p_os;
 }
 
-QDebug operator<<(QDebug p_debug, Polygon const& p_polygon) {
-  auto const& vertices = p_polygon.m_vertices;
-
-  p_debug.nospace() << vertices.size() << ";";
-  for (unsigned k = 0; k < vertices.size(); k++) {
-    p_debug.nospace() << vertices.at(k) << ";";
-  }
-
-  return p_debug.maybeSpace();
-}
-
 }
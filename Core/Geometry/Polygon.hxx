@@ -3,8 +3,11 @@
 
 #include <vector>
 #include <iostream>
+#include <utility>
 
+#include "Core/Geometry/Point.hxx"
 #include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/BoundingBox.hxx"
 
 namespace ppxl {
 
@@ -13,14 +16,19 @@ class Vector;
 
 class Polygon {
 public:
+  // Edge k goes from V(k) to V(k+1)
+  using EdgesPair = std::pair<unsigned int, unsigned int>;
 
   Polygon(std::vector<Point> const& p_vertices = std::vector<Point>());
   Polygon(int p_xMin, int p_xMax, int p_yMin, int p_yMax, unsigned int p_verticesCount);
-  Polygon(Polygon const& p_polygon);
-  virtual ~Polygon();
+  Polygon(Polygon const& p_polygon) = default;
+  Polygon(Polygon&& p_polygon) noexcept = default;
+  ~Polygon() = default;
+
+  Polygon& operator=(Polygon const& p_polygon) = default;
+  Polygon& operator=(Polygon&& p_polygon) noexcept = default;
 
   inline bool HasEnoughVertices() const { return m_vertices.size() > 2; }
-  inline std::vector<Point>& GetVertices() { return m_vertices; }
   inline std::vector<Point> const& GetVertices() const { return m_vertices; }
   void SetVertices(std::vector<Point> const& p_vertices);
   inline unsigned long GetVerticesCount() const { return m_vertices.size(); }
@@ -38,16 +46,27 @@ public:
   bool NewPointIsGood(Point const& p_vertex) const;
 
   bool IsPointInside(Point const& P) const;
+  std::vector<bool> ArePointsInside(std::vector<Point> const& p_points) const;
   bool IsPointNearOneEdge(Point const& M, double p_tolerance) const;
 
+  // One Segment::Intersection per edge [V(k) V(k+1)] against p_line
+  void ComputeIntersections(Segment const& p_line, std::vector<Segment::Intersection>& p_intersections) const;
   bool IsCrossing(Segment const& p_line) const;
   bool IsGoodSegment(Segment const& p_line) const;
+  // No null edge, no aligned consecutive edges, and no crossing edges
   bool IsGoodPolygon() const;
+  // Pairs of non adjacent edges that cross, the lower edge first, sorted
+  std::vector<EdgesPair> ComputeCrossingEdges() const;
 
-  inline void Clear() { m_vertices.clear(); }
+  inline void Clear() { m_vertices.clear(); InvalidateCaches(); }
 
+  // Computed together in one pass over the vertices, cached, and moved along on translation
   double OrientedArea() const;
   Point Barycenter() const;
+  BoundingBox GetBoundingBox() const;
+
+  // Caches are built on demand by const methods: threads sharing a polygon should build them first
+  void BuildCaches() const;
 
   double ComputeAngleFromPoint(double p_x, double p_y);
 
@@ -59,10 +78,31 @@ public:
   friend Polygon& operator<<(Polygon& p_polygon, std::vector<Point> const& p_vertices);
 
   friend std::ostream& operator<<(std::ostream& p_os, Polygon const& p_polygon);
-  friend QDebug operator<<(QDebug p_debug, Polygon const& p_model);
 
 private:
+  inline void InvalidateCaches() { m_edgesCacheValid = false; m_metricsCacheValid = false; }
+  void UpdateEdgesCache() const;
+  void UpdateMetricsCache() const;
+  bool AreEdgesCrossing(unsigned int p_edge1, unsigned int p_edge2) const;
+  bool HasCrossingEdges() const;
+  static bool AddEdgeWinding(double p_ax, double p_ay, double p_bx, double p_by, double p_dx, double p_dy,
+    double p_px, double p_py, int& p_windingNumber);
+
   std::vector<Point> m_vertices;
+
+  // Edges as a structure of arrays: edge k goes from (x0, y0) along (dx, dy) to the start of edge k+1.
+  // Built on demand by the predicates, and invalidated each time a vertex changes.
+  mutable std::vector<double> m_edgesX0;
+  mutable std::vector<double> m_edgesY0;
+  mutable std::vector<double> m_edgesDx;
+  mutable std::vector<double> m_edgesDy;
+  mutable bool m_edgesCacheValid;
+
+  // Area, barycenter and box. Unlike the edges, they stay valid through a translation.
+  mutable double m_area;
+  mutable Point m_barycenter;
+  mutable BoundingBox m_boundingBox;
+  mutable bool m_metricsCacheValid;
 };
 
 }
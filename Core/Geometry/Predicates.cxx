@@ -0,0 +1,69 @@
+#include "Core/Geometry/Predicates.hxx"
+
+namespace ppxl {
+
+namespace {
+
+constexpr double Splitter = 134217729.;   // 2^27 + 1
+
+// p_sum + p_error == p_a + p_b exactly
+inline void TwoSum(double p_a, double p_b, double& p_sum, double& p_error) {
+  p_sum = p_a + p_b;
+  double bVirtual = p_sum - p_a;
+  double aVirtual = p_sum - bVirtual;
+  p_error = (p_a - aVirtual) + (p_b - bVirtual);
+}
+
+// p_product + p_error == p_a * p_b exactly (Dekker)
+inline void TwoProduct(double p_a, double p_b, double& p_product, double& p_error) {
+  p_product = p_a*p_b;
+  auto split = [](double p_value, double& p_high, double& p_low) {
+    double c = Splitter*p_value;
+    p_high = c - (c - p_value);
+    p_low = p_value - p_high;
+  };
+  double aHigh, aLow, bHigh, bLow;
+  split(p_a, aHigh, aLow);
+  split(p_b, bHigh, bLow);
+  p_error = aLow*bLow - (((p_product - aHigh*bHigh) - aLow*bHigh) - aHigh*bLow);
+}
+
+// Adds p_value to the nonoverlapping expansion p_expansion, sorted by increasing magnitude
+inline void GrowExpansion(double* p_expansion, int& p_length, double p_value) {
+  double q = p_value;
+  for (int i = 0; i < p_length; ++i) {
+    TwoSum(q, p_expansion[i], q, p_expansion[i]);
+  }
+  p_expansion[p_length++] = q;
+}
+
+}
+
+double Predicates::Orient2dExact(double p_ax, double p_ay, double p_bx, double p_by, double p_cx, double p_cy) {
+  // ax.by - ay.bx + bx.cy - by.cx + cx.ay - cy.ax, every product split in two exact terms
+  double const factors[6][2] = {
+    {p_ax, p_by}, {-p_ay, p_bx},
+    {p_bx, p_cy}, {-p_by, p_cx},
+    {p_cx, p_ay}, {-p_cy, p_ax}
+  };
+
+  double expansion[12];
+  int length = 0;
+  for (auto const& factor: factors) {
+    double product, error;
+    TwoProduct(factor[0], factor[1], product, error);
+    GrowExpansion(expansion, length, error);
+    GrowExpansion(expansion, length, product);
+  }
+
+  // The largest nonzero component carries the sign of the sum
+  for (int i = length-1; i >= 0; --i) {
+    if (expansion[i] != 0.) {
+      return expansion[i];
+    }
+  }
+
+  return 0.;
+}
+
+}
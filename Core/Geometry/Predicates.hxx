@@ -0,0 +1,44 @@
+#ifndef PREDICATES_HXX
+#define PREDICATES_HXX
+
+#include <atomic>
+#include <cmath>    // abs
+
+namespace ppxl {
+
+// Adaptive-precision predicates: the floating point determinant is trusted when it is larger
+// than its rounding error bound, and recomputed with exact expansion arithmetic otherwise.
+class Predicates {
+public:
+  // Opt-in: Segment, Vector and Polygon then classify through the exact predicates instead of
+  // comparing determinants against DBL_EPSILON tolerances.
+  // Process wide: set it before starting the solver or validator threads, not while they run.
+  static inline void SetExact(bool p_exact) { m_exact.store(p_exact, std::memory_order_relaxed); }
+  static inline bool IsExact() { return m_exact.load(std::memory_order_relaxed); }
+
+  // Positive if C is on the left of (AB), negative if on the right, null if A, B and C are aligned.
+  // Only the sign is exact, as long as the products are rounded apart: ppxl-core.pro turns off
+  // floating point contraction, which would fuse them into an FMA.
+  static inline double Orient2d(double p_ax, double p_ay, double p_bx, double p_by, double p_cx, double p_cy) {
+    double detLeft = (p_ax - p_cx)*(p_by - p_cy);
+    double detRight = (p_ay - p_cy)*(p_bx - p_cx);
+    double det = detLeft - detRight;
+    if (std::abs(det) >= OrientErrorBound*(std::abs(detLeft) + std::abs(detRight))) {
+      return det;
+    }
+    return Orient2dExact(p_ax, p_ay, p_bx, p_by, p_cx, p_cy);
+  }
+
+private:
+  // Relative rounding error bound of the determinant above, see Shewchuk's orient2d
+  static constexpr double Epsilon = 1.1102230246251565e-16;   // 2^-53
+  static constexpr double OrientErrorBound = (3. + 16.*Epsilon)*Epsilon;
+
+  static double Orient2dExact(double p_ax, double p_ay, double p_bx, double p_by, double p_cx, double p_cy);
+
+  static inline std::atomic<bool> m_exact{false};
+};
+
+}
+
+#endif
@@ -1,30 +1,23 @@
 #include "Core/Geometry/Segment.hxx"
 
 #include "Core/Geometry/Vector.hxx"
+#include "Core/Geometry/Predicates.hxx"
 
-#include <QDebug>
-
-#include <cmath>    // abs
+#include <cmath>    // abs, sqrt
+#include <algorithm> // min, max
 #include <cfloat>   // DBL_EPSILON
+#include <type_traits>
 
-namespace ppxl {
-
-Segment::Segment(Point const& p_a, Point const& p_b) {
-  m_a = p_a;
-  m_b = p_b;
-}
-
-Segment::Segment(double p_xa, double p_ya, double p_xb, double p_yb) {
-  m_a = Point(p_xa, p_ya);
-  m_b = Point(p_xb, p_yb);
-}
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
 
-Segment::Segment(Segment const& p_segment) {
-  m_a = p_segment.m_a;
-  m_b = p_segment.m_b;
-}
+namespace ppxl {
 
-Segment::~Segment() = default;
+static_assert(std::is_trivially_copyable<Segment>::value, "Segment must stay a plain value type");
+static_assert(sizeof(Segment) == 2*sizeof(Point), "Segment must not carry anything but its end points");
 
 Point Segment::GetCenter() const {
   return Point((GetA().GetX() + GetB().GetX())/2., (GetA().GetY() + GetB().GetY())/2.);
@@ -91,23 +84,45 @@ Point Segment::GetOtherBoundary(Point const& p_boundary) {
 }
 
 Segment::Side Segment::Location(Point const& p_point) const {
-  Point A(m_a);
-  Point B(m_b);
+  return Location(m_a.GetX(), m_a.GetY(), m_b.GetX(), m_b.GetY(), p_point.GetX(), p_point.GetY());
+}
+
+bool Segment::SameSide(Point const& P, Point const& Q) const {
+  Side locationP = Location(P);
+  Side locationQ = Location(Q);
+  return (locationP == locationQ
+       && locationP != OnSegmentInside
+       && locationP != OnSegmentOutside
+       && locationP != IsBoundA
+       && locationP != IsBoundB);
+}
+
+Segment::Intersection Segment::ComputeIntersection(Point const& P, Point const& Q) const {
+  return ComputeIntersection(m_a.GetX(), m_a.GetY(), m_b.GetX(), m_b.GetY(), P.GetX(), P.GetY(), Q.GetX(), Q.GetY());
+}
+
+Segment::Intersection Segment::ComputeIntersection(Segment const& p_segment) const {
+  return ComputeIntersection(p_segment.GetA(), p_segment.GetB());
+}
+
+Segment::Side Segment::Location(double p_ax, double p_ay, double p_bx, double p_by, double p_px, double p_py) {
+  if (Predicates::IsExact()) {
+    return LocationExact(p_ax, p_ay, p_bx, p_by, p_px, p_py, Predicates::Orient2d(p_ax, p_ay, p_bx, p_by, p_px, p_py));
+  }
 
-  if (A == p_point) {
+  if (std::abs(p_ax - p_px) < DBL_EPSILON && std::abs(p_ay - p_py) < DBL_EPSILON) {
     return IsBoundA;
   }
-  if (B == p_point) {
+  if (std::abs(p_bx - p_px) < DBL_EPSILON && std::abs(p_by - p_py) < DBL_EPSILON) {
     return IsBoundB;
   }
 
-  Vector vAB = B - A;
-  Vector vAP = p_point - A;
-
-  double det = Vector::Determinant(vAB, vAP);
-  if (Vector::AreColinear(vAB, vAP)) {
-    if ((Point::Distance(A, p_point) < Point::Distance(A, B))
-     && (Point::Distance(B, p_point) < Point::Distance(A, B))) {
+  double det = (p_ax - p_bx)*(p_ay - p_py) - (p_ay - p_by)*(p_ax - p_px);
+  if (std::abs(det) < 100.*DBL_EPSILON) {
+    double distanceAB = std::sqrt((p_bx - p_ax)*(p_bx - p_ax) + (p_by - p_ay)*(p_by - p_ay));
+    double distanceAP = std::sqrt((p_px - p_ax)*(p_px - p_ax) + (p_py - p_ay)*(p_py - p_ay));
+    double distanceBP = std::sqrt((p_px - p_bx)*(p_px - p_bx) + (p_py - p_by)*(p_py - p_by));
+    if (distanceAP < distanceAB && distanceBP < distanceAB) {
       return OnSegmentInside;
     } else {
       return OnSegmentOutside;
@@ -119,59 +134,233 @@ Segment::Side Segment::Location(Point const& p_point) const {
   return OnRight;
 }
 
-bool Segment::SameSide(Point const& P, Point const& Q) const {
-  Side locationP = Location(P);
-  Side locationQ = Location(Q);
-  return (locationP == locationQ
-       && locationP != OnSegmentInside
-       && locationP != OnSegmentOutside
-       && locationP != IsBoundA
-       && locationP != IsBoundB);
+Segment::Intersection Segment::ComputeIntersection(double p_ax, double p_ay, double p_bx, double p_by,
+  double p_px, double p_py, double p_qx, double p_qy) {
+
+  if (Predicates::IsExact()) {
+    return ComputeIntersectionExact(p_ax, p_ay, p_bx, p_by, p_px, p_py, p_qx, p_qy);
+  }
+
+  auto samePoint = [](double p_x1, double p_y1, double p_x2, double p_y2) {
+    return std::abs(p_x1 - p_x2) < DBL_EPSILON && std::abs(p_y1 - p_y2) < DBL_EPSILON;
+  };
+  auto distance = [](double p_x1, double p_y1, double p_x2, double p_y2) {
+    return std::sqrt((p_x2 - p_x1)*(p_x2 - p_x1) + (p_y2 - p_y1)*(p_y2 - p_y1));
+  };
+
+  // Deal with colinear
+  if (std::abs((p_ax - p_bx)*(p_py - p_qy) - (p_ay - p_by)*(p_px - p_qx)) < 100.*DBL_EPSILON
+   || samePoint(p_ax, p_ay, p_px, p_py) || samePoint(p_ax, p_ay, p_qx, p_qy)
+   || samePoint(p_bx, p_by, p_px, p_py) || samePoint(p_bx, p_by, p_qx, p_qy)) {
+    if (std::abs((p_ax - p_px)*(p_ay - p_qy) - (p_ay - p_py)*(p_ax - p_qx)) < 100.*DBL_EPSILON
+     && distance(p_px, p_py, p_qx, p_qy) > distance(p_ax, p_ay, p_bx, p_by)) {
+      return Edge;
+    } else {
+      return None;
+    }
+  }
+
+  Side positionP = Location(p_ax, p_ay, p_bx, p_by, p_px, p_py);
+  Side positionQ = Location(p_ax, p_ay, p_bx, p_by, p_qx, p_qy);
+  Side positionA = Location(p_px, p_py, p_qx, p_qy, p_ax, p_ay);
+  Side positionB = Location(p_px, p_py, p_qx, p_qy, p_bx, p_by);
+
+  return ClassifyIntersection(positionP, positionQ, positionA, positionB);
 }
 
-Segment::Intersection Segment::ComputeIntersection(Point const& P, Point const& Q) const {
-  Point A = m_a;
-  Point B = m_b;
+Segment::Side Segment::LocationExact(double p_ax, double p_ay, double p_bx, double p_by, double p_px, double p_py,
+  double p_orientation) {
+  if (p_px == p_ax && p_py == p_ay) {
+    return IsBoundA;
+  }
+  if (p_px == p_bx && p_py == p_by) {
+    return IsBoundB;
+  }
 
-  Vector vAB(B - A);
-  Vector vPQ(Q - P);
+  if (p_orientation > 0.) {
+    return OnLeft;
+  } else if (p_orientation < 0.) {
+    return OnRight;
+  }
+
+  // Aligned: compare along whichever axis [AB] is not orthogonal to
+  bool inside = (p_ax != p_bx)
+    ? (std::min(p_ax, p_bx) < p_px && p_px < std::max(p_ax, p_bx))
+    : (std::min(p_ay, p_by) < p_py && p_py < std::max(p_ay, p_by));
+  return inside ? OnSegmentInside : OnSegmentOutside;
+}
+
+Segment::Intersection Segment::ComputeIntersectionExact(double p_ax, double p_ay, double p_bx, double p_by,
+  double p_px, double p_py, double p_qx, double p_qy) {
+
+  auto strictlySameSign = [](double p_value1, double p_value2) {
+    return (p_value1 > 0. && p_value2 > 0.) || (p_value1 < 0. && p_value2 < 0.);
+  };
+  auto aligned = [](Side p_side) {
+    return p_side != OnLeft && p_side != OnRight;
+  };
+
+  // Early out when P and Q (resp. A and B) are strictly on the same side of (AB) (resp. (PQ))
+  double orientationP = Predicates::Orient2d(p_ax, p_ay, p_bx, p_by, p_px, p_py);
+  double orientationQ = Predicates::Orient2d(p_ax, p_ay, p_bx, p_by, p_qx, p_qy);
+  if (strictlySameSign(orientationP, orientationQ)) {
+    return None;
+  }
+  double orientationA = Predicates::Orient2d(p_px, p_py, p_qx, p_qy, p_ax, p_ay);
+  double orientationB = Predicates::Orient2d(p_px, p_py, p_qx, p_qy, p_bx, p_by);
+  if (strictlySameSign(orientationA, orientationB)) {
+    return None;
+  }
+
+  Side positionP = LocationExact(p_ax, p_ay, p_bx, p_by, p_px, p_py, orientationP);
+  Side positionQ = LocationExact(p_ax, p_ay, p_bx, p_by, p_qx, p_qy, orientationQ);
+  Side positionA = LocationExact(p_px, p_py, p_qx, p_qy, p_ax, p_ay, orientationA);
+  Side positionB = LocationExact(p_px, p_py, p_qx, p_qy, p_bx, p_by, orientationB);
 
   // Deal with colinear
-  if (Vector::AreColinear(vAB, vPQ) || A == P || A == Q || B == P || B == Q) {
-    Vector vAP(P - A);
-    Vector vAQ(Q - A);
-    if (Vector::AreColinear(vAP, vAQ)
-     && Point::Distance(P, Q) > Point::Distance(A, B)) {
+  bool sharedBound = (p_ax == p_px && p_ay == p_py) || (p_ax == p_qx && p_ay == p_qy)
+                  || (p_bx == p_px && p_by == p_py) || (p_bx == p_qx && p_by == p_qy);
+  if (sharedBound || (aligned(positionP) && aligned(positionQ))) {
+    double squaredLengthAB = (p_bx - p_ax)*(p_bx - p_ax) + (p_by - p_ay)*(p_by - p_ay);
+    double squaredLengthPQ = (p_qx - p_px)*(p_qx - p_px) + (p_qy - p_py)*(p_qy - p_py);
+    if (aligned(positionA) && squaredLengthPQ > squaredLengthAB) {
       return Edge;
     } else {
       return None;
     }
   }
 
-  Segment PQ(P, Q);
-  Side positionP = Location(P);
-  Side positionQ = Location(Q);
-  Side positionA = PQ.Location(A);
-  Side positionB = PQ.Location(B);
-
-  if (!SameSide(P, Q)
-   && !PQ.SameSide(A, B)
-   && positionP != OnSegmentInside
-   && positionQ != OnSegmentInside
-   && positionA != OnSegmentInside
-   && positionB != OnSegmentInside) {
+  return ClassifyIntersection(positionP, positionQ, positionA, positionB);
+}
+
+Segment::Intersection Segment::ClassifyIntersection(Side p_positionP, Side p_positionQ, Side p_positionA, Side p_positionB) {
+  // P and Q (resp. A and B) are strictly on the same side of [AB] (resp. [PQ])
+  bool sameSidePQ = p_positionP == p_positionQ && (p_positionP == OnLeft || p_positionP == OnRight);
+  bool sameSideAB = p_positionA == p_positionB && (p_positionA == OnLeft || p_positionA == OnRight);
+
+  if (!sameSidePQ
+   && !sameSideAB
+   && p_positionP != OnSegmentInside
+   && p_positionQ != OnSegmentInside
+   && p_positionA != OnSegmentInside
+   && p_positionB != OnSegmentInside) {
     return Regular;
-  } else if (positionA == OnSegmentInside) {
+  } else if (p_positionA == OnSegmentInside) {
     return FirstVertexRegular;
-  } else if (positionB == OnSegmentInside) {
+  } else if (p_positionB == OnSegmentInside) {
     return SecondVertexRegular;
   }
 
   return None;
 }
 
-Segment::Intersection Segment::ComputeIntersection(Segment const& p_segment) const {
-  return ComputeIntersection(p_segment.GetA(), p_segment.GetB());
+namespace {
+
+#if defined(__AVX__)
+struct Lanes {
+  using Type = __m256d;
+  static constexpr unsigned int Width = 4;
+  static Type Load(double const* p_values) { return _mm256_loadu_pd(p_values); }
+  static Type Set(double p_value) { return _mm256_set1_pd(p_value); }
+  static Type Sub(Type p_a, Type p_b) { return _mm256_sub_pd(p_a, p_b); }
+  static Type Mul(Type p_a, Type p_b) { return _mm256_mul_pd(p_a, p_b); }
+  static Type Abs(Type p_a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), p_a); }
+  static Type Lt(Type p_a, Type p_b) { return _mm256_cmp_pd(p_a, p_b, _CMP_LT_OQ); }
+  static Type Gt(Type p_a, Type p_b) { return _mm256_cmp_pd(p_a, p_b, _CMP_GT_OQ); }
+  static Type And(Type p_a, Type p_b) { return _mm256_and_pd(p_a, p_b); }
+  static Type Or(Type p_a, Type p_b) { return _mm256_or_pd(p_a, p_b); }
+  static Type Xor(Type p_a, Type p_b) { return _mm256_xor_pd(p_a, p_b); }
+  static int Mask(Type p_a) { return _mm256_movemask_pd(p_a); }
+};
+#define PPXL_SEGMENT_LANES
+#elif defined(__SSE2__) || defined(_M_X64)
+struct Lanes {
+  using Type = __m128d;
+  static constexpr unsigned int Width = 2;
+  static Type Load(double const* p_values) { return _mm_loadu_pd(p_values); }
+  static Type Set(double p_value) { return _mm_set1_pd(p_value); }
+  static Type Sub(Type p_a, Type p_b) { return _mm_sub_pd(p_a, p_b); }
+  static Type Mul(Type p_a, Type p_b) { return _mm_mul_pd(p_a, p_b); }
+  static Type Abs(Type p_a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), p_a); }
+  static Type Lt(Type p_a, Type p_b) { return _mm_cmplt_pd(p_a, p_b); }
+  static Type Gt(Type p_a, Type p_b) { return _mm_cmpgt_pd(p_a, p_b); }
+  static Type And(Type p_a, Type p_b) { return _mm_and_pd(p_a, p_b); }
+  static Type Or(Type p_a, Type p_b) { return _mm_or_pd(p_a, p_b); }
+  static Type Xor(Type p_a, Type p_b) { return _mm_xor_pd(p_a, p_b); }
+  static int Mask(Type p_a) { return _mm_movemask_pd(p_a); }
+};
+#define PPXL_SEGMENT_LANES
+#endif
+
+}
+
+void Segment::ComputeIntersections(double p_px, double p_py, double p_qx, double p_qy,
+  double const* p_ringX, double const* p_ringY, unsigned int p_count, Intersection* p_intersections) {
+
+  unsigned int k = 0;
+
+#ifdef PPXL_SEGMENT_LANES
+  // Lanes where every predicate of the scalar path is clear of its tolerance reduce to four
+  // determinant signs. Any other lane (colinear, shared bound, point on a line) goes scalar.
+  using L = Lanes;
+  L::Type const eps = L::Set(DBL_EPSILON);
+  L::Type const tol = L::Set(100.*DBL_EPSILON);
+  L::Type const px = L::Set(p_px);
+  L::Type const py = L::Set(p_py);
+  L::Type const qx = L::Set(p_qx);
+  L::Type const qy = L::Set(p_qy);
+  L::Type const pqx = L::Set(p_px - p_qx);
+  L::Type const pqy = L::Set(p_py - p_qy);
+
+  auto samePoint = [&eps](L::Type p_x1, L::Type p_y1, L::Type p_x2, L::Type p_y2) {
+    return L::And(L::Lt(L::Abs(L::Sub(p_x1, p_x2)), eps), L::Lt(L::Abs(L::Sub(p_y1, p_y2)), eps));
+  };
+  auto det = [](L::Type p_ux, L::Type p_uy, L::Type p_vx, L::Type p_vy) {
+    return L::Sub(L::Mul(p_ux, p_vy), L::Mul(p_uy, p_vx));
+  };
+
+  // The lanes only reproduce the tolerance based path: exact mode goes scalar
+  unsigned int lanesCount = Predicates::IsExact() ? 0 : p_count;
+  for (; k + L::Width < lanesCount; k += L::Width) {
+    L::Type ax = L::Load(p_ringX + k);
+    L::Type ay = L::Load(p_ringY + k);
+    L::Type bx = L::Load(p_ringX + k + 1);
+    L::Type by = L::Load(p_ringY + k + 1);
+    L::Type abx = L::Sub(ax, bx);
+    L::Type aby = L::Sub(ay, by);
+
+    L::Type detPQ = det(abx, aby, pqx, pqy);
+    L::Type detP = det(abx, aby, L::Sub(ax, px), L::Sub(ay, py));
+    L::Type detQ = det(abx, aby, L::Sub(ax, qx), L::Sub(ay, qy));
+    L::Type detA = det(pqx, pqy, L::Sub(px, ax), L::Sub(py, ay));
+    L::Type detB = det(pqx, pqy, L::Sub(px, bx), L::Sub(py, by));
+
+    L::Type degenerate = L::Or(
+      L::Or(L::Or(samePoint(ax, ay, px, py), samePoint(ax, ay, qx, qy)),
+            L::Or(samePoint(bx, by, px, py), samePoint(bx, by, qx, qy))),
+      L::Or(L::Or(L::Lt(L::Abs(detPQ), tol), L::Lt(L::Abs(detP), tol)),
+            L::Or(L::Or(L::Lt(L::Abs(detQ), tol), L::Lt(L::Abs(detA), tol)), L::Lt(L::Abs(detB), tol))));
+    L::Type regular = L::And(
+      L::Xor(L::Gt(detP, eps), L::Gt(detQ, eps)),
+      L::Xor(L::Gt(detA, eps), L::Gt(detB, eps)));
+
+    int degenerateMask = L::Mask(degenerate);
+    int regularMask = L::Mask(regular);
+    for (unsigned int lane = 0; lane < L::Width; ++lane) {
+      if (degenerateMask & (1 << lane)) {
+        auto i = k + lane;
+        p_intersections[i] = ComputeIntersection(p_ringX[i], p_ringY[i], p_ringX[i+1], p_ringY[i+1], p_px, p_py, p_qx, p_qy);
+      } else {
+        p_intersections[k + lane] = (regularMask & (1 << lane)) ? Regular : None;
+      }
+    }
+  }
+#endif
+
+  for (; k < p_count; ++k) {
+    auto next = (k+1)%p_count;
+    p_intersections[k] = ComputeIntersection(p_ringX[k], p_ringY[k], p_ringX[next], p_ringY[next], p_px, p_py, p_qx, p_qy);
+  }
 }
 
 void Segment::Translate(Vector const& p_direction) {
@@ -302,14 +491,4 @@ std::ostream& operator<<(std::ostream& p_os, Segment const& p_segment) {
   return p_os << "(Segment) [" << p_segment.GetA() << " " << p_segment.GetB() << "]";
 }
 
-Segment& Segment::operator=(Segment const& p_segment) {
-  m_a = p_segment.m_a;
-  m_b = p_segment.m_b;
-  return *this;
-}
-
-QDebug operator<<(QDebug p_debug, Segment const& p_segment) {
-  return p_debug << "[" << p_segment.GetA() << " " << p_segment.GetB() << "]";
-}
-
 }
@@ -4,10 +4,12 @@
 #include "Core/Geometry/Point.hxx"
 
 #include <string>
+#include <vector>
 #include <cfloat>
 
 namespace ppxl {
 
+// Plain value type: trivially copyable, its two end points and nothing else.
 class Segment {
 public:
   enum Side {
@@ -28,15 +30,13 @@ public:
     None
   };
 
-  Segment(Point const& a = Point(), Point const& b = Point());
-  Segment(double p_xa, double p_ya, double p_xb, double p_yb);
-  Segment(Segment const& p_segment);
-  virtual ~Segment();
+  constexpr Segment(Point const& a = Point(), Point const& b = Point()): m_a(a), m_b(b) {}
+  constexpr Segment(double p_xa, double p_ya, double p_xb, double p_yb): m_a(p_xa, p_ya), m_b(p_xb, p_yb) {}
 
-  inline Point GetA() const { return m_a; }
-  inline Point GetB() const { return m_b; }
-  inline void SetA(Point const& p_a) { m_a = p_a; }
-  inline void SetB(Point const& p_b) { m_b = p_b; }
+  constexpr Point GetA() const { return m_a; }
+  constexpr Point GetB() const { return m_b; }
+  constexpr void SetA(Point const& p_a) { m_a = p_a; }
+  constexpr void SetB(Point const& p_b) { m_b = p_b; }
 
   Point GetCenter() const;
   Vector GetNormal() const;
@@ -50,6 +50,15 @@ public:
   bool SameSide(Point const& P, Point const& Q) const;
   Intersection ComputeIntersection(Point const& P, Point const& Q) const;
   Intersection ComputeIntersection(Segment const& p_segment) const;
+
+  // Same as above, on raw coordinates of segments [AB] and [PQ]
+  static Side Location(double p_ax, double p_ay, double p_bx, double p_by, double p_px, double p_py);
+  static Intersection ComputeIntersection(double p_ax, double p_ay, double p_bx, double p_by,
+    double p_px, double p_py, double p_qx, double p_qy);
+  // Classifies every edge [V(k) V(k+1)] of the closed ring (p_ringX, p_ringY) against [PQ], several
+  // edges at a time when SSE2/AVX is available. Gives exactly what the scalar overload above gives.
+  static void ComputeIntersections(double p_px, double p_py, double p_qx, double p_qy,
+    double const* p_ringX, double const* p_ringY, unsigned int p_count, Intersection* p_intersections);
   static Point IntersectionPoint(Segment const& AB, Segment const& PQ);
 
   bool PointIsInBoundingBox(const Point& C) const;
@@ -67,12 +76,16 @@ public:
   friend bool operator!=(Segment const& p_segment1, Segment const& p_segment2);
   friend bool operator<(Segment const& p_segment1, Segment const& p_segment2);
 
-  Segment& operator=(Segment const& p_segment);
-
   friend std::ostream& operator<<(std::ostream& os, Segment const& p_segment);
-  friend QDebug operator<<(QDebug d, Segment const& p_segment);
 
 private:
+  // Exact counterparts of the raw coordinates overloads, see Predicates::SetExact
+  static Side LocationExact(double p_ax, double p_ay, double p_bx, double p_by, double p_px, double p_py,
+    double p_orientation);
+  static Intersection ComputeIntersectionExact(double p_ax, double p_ay, double p_bx, double p_by,
+    double p_px, double p_py, double p_qx, double p_qy);
+  static Intersection ClassifyIntersection(Side p_positionP, Side p_positionQ, Side p_positionA, Side p_positionB);
+
   Point m_a;
   Point m_b;
 };
@@ -0,0 +1,128 @@
+#include "Core/Geometry/SpatialIndex.hxx"
+
+#include <algorithm>
+
+namespace ppxl {
+
+namespace {
+
+constexpr unsigned int MaxLeafItemsCount = 4;
+
+}
+
+void SpatialIndex::Build(std::vector<BoundingBox> const& p_boxes) {
+  Clear();
+  m_boxes = p_boxes;
+  m_items.resize(m_boxes.size());
+  for (ItemIndex k = 0; k < m_items.size(); ++k) {
+    m_items[k] = k;
+  }
+
+  if (!m_items.empty()) {
+    m_nodes.reserve(2*m_items.size()/MaxLeafItemsCount + 1);
+    m_nodes.resize(1);
+    BuildNode(0, 0, GetItemsCount());
+  }
+}
+
+void SpatialIndex::Clear() {
+  m_nodes.clear();
+  m_items.clear();
+  m_boxes.clear();
+}
+
+void SpatialIndex::BuildNode(unsigned int p_node, unsigned int p_begin, unsigned int p_end) {
+  BoundingBox box;
+  BoundingBox centers;
+  for (unsigned int k = p_begin; k < p_end; ++k) {
+    box.Extend(m_boxes[m_items[k]]);
+    centers.Extend(m_boxes[m_items[k]].GetCenter());
+  }
+  m_nodes[p_node].m_box = box;
+
+  if (p_end - p_begin <= MaxLeafItemsCount) {
+    m_nodes[p_node].m_first = p_begin;
+    m_nodes[p_node].m_count = p_end - p_begin;
+    return;
+  }
+
+  // Median split along the largest spread of the boxes centers
+  bool alongX = centers.GetXMax() - centers.GetXMin() >= centers.GetYMax() - centers.GetYMin();
+  unsigned int middle = (p_begin + p_end)/2;
+  std::nth_element(m_items.begin() + p_begin, m_items.begin() + middle, m_items.begin() + p_end,
+    [this, alongX](ItemIndex p_item1, ItemIndex p_item2) {
+      Point center1 = m_boxes[p_item1].GetCenter();
+      Point center2 = m_boxes[p_item2].GetCenter();
+      return alongX ? center1.GetX() < center2.GetX() : center1.GetY() < center2.GetY();
+    });
+
+  auto firstChild = static_cast<unsigned int>(m_nodes.size());
+  m_nodes[p_node].m_first = firstChild;
+  m_nodes[p_node].m_count = 0;
+  m_nodes.resize(m_nodes.size() + 2);
+  BuildNode(firstChild, p_begin, middle);
+  BuildNode(firstChild + 1, middle, p_end);
+}
+
+void SpatialIndex::Query(Segment const& p_line, std::vector<ItemIndex>& p_candidates) const {
+  if (m_nodes.empty()) {
+    return;
+  }
+
+  // Median splits keep the depth under 32 levels, a node has at most one pending sibling per level
+  unsigned int stack[64];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+
+  BoundingBox lineBox = BoundingBox::FromSegment(p_line);
+  while (stackSize > 0) {
+    Node const& node = m_nodes[stack[--stackSize]];
+    if (!node.m_box.Intersects(lineBox) || !node.m_box.Intersects(p_line)) {
+      continue;
+    }
+
+    if (node.m_count == 0) {
+      stack[stackSize++] = node.m_first;
+      stack[stackSize++] = node.m_first + 1;
+      continue;
+    }
+
+    for (unsigned int k = node.m_first; k < node.m_first + node.m_count; ++k) {
+      BoundingBox const& box = m_boxes[m_items[k]];
+      if (box.Intersects(lineBox) && box.Intersects(p_line)) {
+        p_candidates.push_back(m_items[k]);
+      }
+    }
+  }
+}
+
+void SpatialIndex::Query(BoundingBox const& p_box, std::vector<ItemIndex>& p_candidates) const {
+  if (m_nodes.empty()) {
+    return;
+  }
+
+  unsigned int stack[64];
+  unsigned int stackSize = 0;
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0) {
+    Node const& node = m_nodes[stack[--stackSize]];
+    if (!node.m_box.Intersects(p_box)) {
+      continue;
+    }
+
+    if (node.m_count == 0) {
+      stack[stackSize++] = node.m_first;
+      stack[stackSize++] = node.m_first + 1;
+      continue;
+    }
+
+    for (unsigned int k = node.m_first; k < node.m_first + node.m_count; ++k) {
+      if (m_boxes[m_items[k]].Intersects(p_box)) {
+        p_candidates.push_back(m_items[k]);
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,45 @@
+#ifndef SPATIALINDEX_HXX
+#define SPATIALINDEX_HXX
+
+#include "Core/Geometry/BoundingBox.hxx"
+
+#include <vector>
+
+namespace ppxl {
+
+// Bounding volume hierarchy over a list of boxes, queried by segment. Items are referred to
+// by their position in the list given to Build.
+class SpatialIndex {
+public:
+  using ItemIndex = unsigned int;
+
+  SpatialIndex() = default;
+
+  void Build(std::vector<BoundingBox> const& p_boxes);
+  void Clear();
+  inline unsigned int GetItemsCount() const { return static_cast<unsigned int>(m_items.size()); }
+
+  // Appends every item whose box touches p_line, in no particular order
+  void Query(Segment const& p_line, std::vector<ItemIndex>& p_candidates) const;
+  // Appends every item whose box touches p_box, in no particular order
+  void Query(BoundingBox const& p_box, std::vector<ItemIndex>& p_candidates) const;
+
+private:
+  // Leaves own m_count items from m_first in m_items; inner nodes have m_count == 0
+  // and their children at m_first and m_first+1.
+  struct Node {
+    BoundingBox m_box;
+    unsigned int m_first = 0;
+    unsigned int m_count = 0;
+  };
+
+  void BuildNode(unsigned int p_node, unsigned int p_begin, unsigned int p_end);
+
+  std::vector<Node> m_nodes;
+  std::vector<ItemIndex> m_items;
+  std::vector<BoundingBox> m_boxes;
+};
+
+}
+
+#endif
@@ -2,28 +2,16 @@
 
 #include "Core/Geometry/Point.hxx"
 #include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/Predicates.hxx"
 
 #include <cmath>    // sqrt, abs, atan2
 #include <cfloat>   // DBL_EPSILON
+#include <type_traits>
 
 namespace ppxl {
 
-Vector::Vector(double const& p_x, double const& p_y) {
-  m_x = p_x;
-  m_y = p_y;
-}
-
-Vector::Vector(Point const& p_a, Point const& p_b) {
-  m_x = p_b.GetX()-p_a.GetX();
-  m_y = p_b.GetY()-p_a.GetY();
-}
-
-Vector::Vector(Vector const& p_vector) {
-  m_x = p_vector.m_x;
-  m_y = p_vector.m_y;
-}
-
-Vector::~Vector() = default;
+static_assert(std::is_trivially_copyable<Vector>::value, "Vector must stay a plain value type");
+static_assert(sizeof(Vector) == 2*sizeof(double), "Vector must not carry anything but its coordinates");
 
 Vector Vector::FromSegment(Segment const& p_segment) {
   return Vector(p_segment.GetA(), p_segment.GetB());
@@ -38,57 +26,11 @@ bool operator!=(Vector const& p_vector1, Vector const& p_vector2) {
   return !(p_vector1 == p_vector2);
 }
 
-Vector const& Vector::operator+() const {
-  return *this;
-}
-
-Vector Vector::operator-() const {
-  return Vector(-m_x, -m_y);
-}
-
-Vector& Vector::operator=(Vector const& p_vector) {
-  m_x = p_vector.m_x;
-  m_y = p_vector.m_y;
-  return *this;
-}
-
-Vector operator+(Vector const& p_vector1, Vector const& p_vector2) {
-  return Vector(p_vector1.m_x + p_vector2.m_x, p_vector1.m_y + p_vector2.m_y);
-}
-
-Vector operator-(Vector const& p_vector1, Vector const& p_vector2) {
-  return Vector(p_vector1.m_x - p_vector2.m_x, p_vector1.m_y - p_vector2.m_y);
-}
-
-Vector operator*(Vector const& p_vector, double const& p_scalar) {
-  return Vector(p_vector.m_x * p_scalar, p_vector.m_y * p_scalar);
-}
-
-Vector operator*(double const& p_scalar, Vector const& p_vector) {
-  return Vector(p_vector.m_x * p_scalar, p_vector.m_y * p_scalar);
-}
-
-double operator*(Vector const& p_vector1, Vector const& p_vector2) {
-  return p_vector1.m_x * p_vector2.m_x + p_vector1.m_y * p_vector2.m_y;
-}
-
 Vector operator/(Vector const& p_vector, double const& p_scalar) {
   assert(std::abs(p_scalar) > DBL_EPSILON);
   return Vector(p_vector.m_x / p_scalar, p_vector.m_y / p_scalar);
 }
 
-Vector& Vector::operator+=(Vector const& p_vector) {
-  return *this = (*this + p_vector);
-}
-
-Vector& Vector::operator-=(Vector const& p_vector) {
-  return *this = (*this - p_vector);
-}
-
-Vector& Vector::operator*=(double const& p_scalar) {
-  return *this = (*this * p_scalar);
-}
-
 Vector& Vector::operator/=(double const& p_scalar) {
   return *this = (*this / p_scalar);
 }
@@ -97,10 +39,6 @@ double Vector::Norm() const {
   return std::sqrt(m_x * m_x + m_y * m_y);
 }
 
-double Vector::SquaredNorm() const {
-  return (m_x * m_x + m_y * m_y);
-}
-
 
 Vector Vector::Normalized() const {
   if (IsNull()) {
@@ -132,11 +70,10 @@ bool Vector::IsNull() const
   return Norm() == 0.;
 }
 
-double Vector::Determinant(Vector const& p_vector1, Vector const& p_vector2) {
-  return p_vector1.m_x * p_vector2.m_y - p_vector1.m_y * p_vector2.m_x;
-}
-
 bool Vector::AreColinear(Vector const& p_vector1, Vector const& p_vector2) {
+  if (Predicates::IsExact()) {
+    return Predicates::Orient2d(0., 0., p_vector1.m_x, p_vector1.m_y, p_vector2.m_x, p_vector2.m_y) == 0.;
+  }
   /// Why 100?
   return std::abs(Determinant(p_vector1, p_vector2)) < 100.*DBL_EPSILON;
 }
@@ -156,8 +93,4 @@ std::ostream& operator<<(std::ostream& p_os, Vector const& p_vector) {
   return p_os << "(Vector) (" << p_vector.m_x << "; " << p_vector.m_y << ")";
 }
 
-QDebug operator<<(QDebug p_debug, Vector const& p_vector) {
-  return p_debug << "(" << p_vector.m_x << "; " << p_vector.m_y << ")";
-}
-
 }
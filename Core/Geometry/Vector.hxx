@@ -4,62 +4,69 @@
 #include <iostream>
 #include <cassert>
 
-#include <QDebug>
+#include "Core/Geometry/Point.hxx"
 
 namespace ppxl {
 
-class Point;
 class Segment;
 
+// Plain value type: trivially copyable, two doubles and nothing else.
 class Vector {
 public:
-  Vector(double const& p_x = 0.0, double const& p_y = 0.0);
-  Vector(Point const& p_a, Point const& p_b);
-  Vector(Vector const& p_vector);
-  virtual ~Vector();
+  constexpr Vector(double const& p_x = 0.0, double const& p_y = 0.0): m_x(p_x), m_y(p_y) {}
+  constexpr Vector(Point const& p_a, Point const& p_b): m_x(p_b.GetX()-p_a.GetX()), m_y(p_b.GetY()-p_a.GetY()) {}
 
-  inline double GetX() const { return m_x; }
-  inline double GetY() const { return m_y; }
+  constexpr double GetX() const { return m_x; }
+  constexpr double GetY() const { return m_y; }
 
-  inline void SetX(double p_x) { m_x = p_x; }
-  inline void SetY(double p_y) { m_y = p_y; }
+  constexpr void SetX(double p_x) { m_x = p_x; }
+  constexpr void SetY(double p_y) { m_y = p_y; }
 
   static Vector FromSegment(Segment const& p_segment);
 
   friend bool operator==(Vector const& p_vector1, Vector const& p_vector2);
   friend bool operator!=(Vector const& p_vector1, Vector const& p_vector2);
 
-  Vector const& operator+() const;
-  Vector operator-() const;
-
-  Vector& operator=(Vector const& p_vector);
-
-  friend Vector operator+(Vector const& p_vector1, Vector const& p_vector2);
-  friend Vector operator-(Vector const& p_vector1, Vector const& p_vector2);
-  friend Vector operator*(Vector const& p_vector, double const& p_scalar);
-  friend Vector operator*(double const& k, Vector const& p_vector);
-  friend double operator*(Vector const& p_vector1, Vector const& p_vector2);
+  constexpr Vector const& operator+() const { return *this; }
+  constexpr Vector operator-() const { return Vector(-m_x, -m_y); }
+
+  friend constexpr Vector operator+(Vector const& p_vector1, Vector const& p_vector2) {
+    return Vector(p_vector1.m_x + p_vector2.m_x, p_vector1.m_y + p_vector2.m_y);
+  }
+  friend constexpr Vector operator-(Vector const& p_vector1, Vector const& p_vector2) {
+    return Vector(p_vector1.m_x - p_vector2.m_x, p_vector1.m_y - p_vector2.m_y);
+  }
+  friend constexpr Vector operator*(Vector const& p_vector, double const& p_scalar) {
+    return Vector(p_vector.m_x * p_scalar, p_vector.m_y * p_scalar);
+  }
+  friend constexpr Vector operator*(double const& p_scalar, Vector const& p_vector) {
+    return Vector(p_vector.m_x * p_scalar, p_vector.m_y * p_scalar);
+  }
+  friend constexpr double operator*(Vector const& p_vector1, Vector const& p_vector2) {
+    return p_vector1.m_x * p_vector2.m_x + p_vector1.m_y * p_vector2.m_y;
+  }
   friend Vector operator/(Vector const& p_vector, double const&p_scalar);
 
-  Vector& operator+=(Vector const& p_vector);
-  Vector& operator-=(Vector const& p_vector);
-  Vector& operator*=(double const&p_scalar);
+  constexpr Vector& operator+=(Vector const& p_vector) { return *this = (*this + p_vector); }
+  constexpr Vector& operator-=(Vector const& p_vector) { return *this = (*this - p_vector); }
+  constexpr Vector& operator*=(double const&p_scalar) { return *this = (*this * p_scalar); }
   Vector& operator/=(double const&p_scalar);
 
   double Norm() const;
-  double SquaredNorm() const;
+  constexpr double SquaredNorm() const { return (m_x * m_x + m_y * m_y); }
   Vector Normalized() const;
   Vector& Normalize();
 
   bool IsNull() const;
 
-  static double Determinant(Vector const& p_vector1, Vector const& p_vector2);
+  static constexpr double Determinant(Vector const& p_vector1, Vector const& p_vector2) {
+    return p_vector1.m_x * p_vector2.m_y - p_vector1.m_y * p_vector2.m_x;
+  }
   static bool AreColinear(Vector const& p_vector1, Vector const& p_vector2);
   static bool AreOrthogonal(Vector const& p_vector1, Vector const& p_vector2);
   static double Angle(Vector const& p_vector1, Vector const& p_vector2);
 
   friend std::ostream& operator<<(std::ostream& p_os, Vector const& p_vector);
-  friend QDebug operator<<(QDebug p_debug, Vector const& p_vector);
 
 private:
   double m_x;
@@ -0,0 +1,57 @@
+#include "LatencyHistogram.hxx"
+
+LatencyHistogram::LatencyHistogram():
+  m_counts(),
+  m_maxMicroseconds(0.) {
+
+  Clear();
+}
+
+void LatencyHistogram::Record(double p_microseconds) {
+  m_counts[GetBucket(p_microseconds)].fetch_add(1, std::memory_order_relaxed);
+
+  double maxMicroseconds = m_maxMicroseconds.load(std::memory_order_relaxed);
+  while (p_microseconds > maxMicroseconds && !m_maxMicroseconds.compare_exchange_weak(maxMicroseconds, p_microseconds, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Clear() {
+  for (auto& count: m_counts) {
+    count.store(0, std::memory_order_relaxed);
+  }
+  m_maxMicroseconds.store(0., std::memory_order_relaxed);
+}
+
+int LatencyHistogram::GetBucket(double p_microseconds) {
+  int bucket = 0;
+  for (double bound = 1.; bucket < BucketsCount-1 && p_microseconds >= bound; bound *= 2.) {
+    ++bucket;
+  }
+  return bucket;
+}
+
+std::uint64_t LatencyHistogram::GetTotalCount() const {
+  std::uint64_t totalCount = 0;
+  for (int bucket = 0; bucket < BucketsCount; ++bucket) {
+    totalCount += GetCount(bucket);
+  }
+  return totalCount;
+}
+
+void LatencyHistogram::Dump(std::ostream& p_os) const {
+  for (int bucket = 0; bucket < BucketsCount; ++bucket) {
+    auto count = GetCount(bucket);
+    if (count == 0) {
+      continue;
+    }
+    if (bucket == 0) {
+      p_os << "< 1 us: ";
+    } else if (bucket == BucketsCount-1) {
+      p_os << ">= " << (1ull << (bucket-1)) << " us: ";
+    } else {
+      p_os << (1ull << (bucket-1)) << "-" << (1ull << bucket) << " us: ";
+    }
+    p_os << count << std::endl;
+  }
+  p_os << "max: " << GetMaxMicroseconds() << " us" << std::endl;
+}
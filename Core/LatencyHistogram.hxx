@@ -0,0 +1,34 @@
+#ifndef LATENCYHISTOGRAM_HXX
+#define LATENCYHISTOGRAM_HXX
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+// Counts durations in power of two buckets of microseconds: bucket 0 is below 1 us, bucket k
+// from 2^(k-1) to 2^k us, the last one everything above. Recording is lock free, from any thread.
+class LatencyHistogram {
+public:
+  static constexpr int BucketsCount = 24;
+
+  LatencyHistogram();
+
+  void Record(double p_microseconds);
+  void Clear();
+
+  static int GetBucket(double p_microseconds);
+  inline std::uint64_t GetCount(int p_bucket) const { return m_counts[p_bucket].load(std::memory_order_relaxed); }
+  std::uint64_t GetTotalCount() const;
+  inline double GetMaxMicroseconds() const { return m_maxMicroseconds.load(std::memory_order_relaxed); }
+
+  // One line per non empty bucket
+  void Dump(std::ostream& p_os) const;
+  friend std::ostream& operator<<(std::ostream& p_os, LatencyHistogram const& p_histogram) { p_histogram.Dump(p_os); return p_os; }
+
+private:
+  std::array<std::atomic<std::uint64_t>, BucketsCount> m_counts;
+  std::atomic<double> m_maxMicroseconds;
+};
+
+#endif
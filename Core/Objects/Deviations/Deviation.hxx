@@ -12,6 +12,9 @@ public:
   ~Deviation() override;
 
   virtual std::vector<ppxl::Segment> DeviateLine(ppxl::Segment const& p_line) const = 0;
+  // Same hit test as DeviateLine, without building the lines: distance from the line's
+  // first bound to where it is deviated, false if it is not.
+  virtual bool ComputeHitDistance(ppxl::Segment const& p_line, double& p_distance) const = 0;
 };
 
 #endif
@@ -0,0 +1,98 @@
+#include "DeviationTracer.hxx"
+
+#include "Core/Geometry/Vector.hxx"
+#include "Core/Objects/Deviations/Deviation.hxx"
+#include "Core/Trace.hxx"
+
+#include <limits>
+#include <cassert>
+
+DeviationTracer::DeviationTracer() {
+  m_lines.reserve(MaxBouncesCount+1);
+  m_deviatedLines.reserve(MaxBouncesCount);
+}
+
+void DeviationTracer::SetDeviationsList(std::vector<Object*> const& p_deviationsList) {
+  m_deviationsList.clear();
+  for (auto deviation: p_deviationsList) {
+    AddDeviation(deviation);
+  }
+}
+
+void DeviationTracer::AddDeviation(Object* p_deviation) {
+  m_deviationsList.push_back(static_cast<Deviation const*>(p_deviation));
+}
+
+std::vector<ppxl::Segment> const& DeviationTracer::Trace(ppxl::Segment const& p_line) {
+  m_lines.clear();
+  m_deviatedLines.clear();
+
+  ppxl::Segment line = p_line;
+  double firstLineLength = -1.;
+  Deviation const* lastDeviation = nullptr;
+
+  Deviation const* nearestDeviation = GetNearestDeviation(line);
+  // A deviated line starts on its deviation, which therefore cannot deviate it again
+  while (nearestDeviation && nearestDeviation != lastDeviation) {
+    std::vector<ppxl::Segment> deviateLines = nearestDeviation->DeviateLine(line);
+    // Init firstLineLength
+    if (firstLineLength < 0.) {
+      firstLineLength = deviateLines.at(0).Length();
+    }
+
+    // At least two lines have to be here: the line drawn and its deviation
+    assert(deviateLines.size() > 1);
+
+    // Make the deviated line's length the same as the firstLine one
+    ppxl::Segment deviateLine = deviateLines.at(1);
+    ppxl::Point A = deviateLine.GetA();
+    ppxl::Point B = deviateLine.GetB();
+    ppxl::Vector lu = firstLineLength * ppxl::Vector(A, B).Normalize();
+    ppxl::Point BB(lu.GetX(), lu.GetY());
+    deviateLine.SetB(A + BB);
+
+    // Keep the line up to the deviation only, and follow its reflexion
+    m_lines.push_back(deviateLines.at(0));
+    line = deviateLine;
+    PPXL_TRACE(eSlicer, "Bounce " << m_lines.size() << ": " << deviateLines.at(0) << " " << deviateLine);
+
+    if (IsRepeated(deviateLine)) {
+      break;
+    }
+    m_deviatedLines.push_back(deviateLine);
+    if (m_deviatedLines.size() == MaxBouncesCount) {
+      break;
+    }
+
+    lastDeviation = nearestDeviation;
+    nearestDeviation = GetNearestDeviation(line);
+  }
+  m_lines.push_back(line);
+
+  return m_lines;
+}
+
+Deviation const* DeviationTracer::GetNearestDeviation(ppxl::Segment const& p_line) const {
+  double minDist = std::numeric_limits<double>::infinity();
+  Deviation const* nearestDeviation = nullptr;
+
+  for (auto deviation: m_deviationsList) {
+    double distance;
+    if (deviation->ComputeHitDistance(p_line, distance) && distance < minDist) {
+      minDist = distance;
+      nearestDeviation = deviation;
+    }
+  }
+
+  return nearestDeviation;
+}
+
+bool DeviationTracer::IsRepeated(ppxl::Segment const& p_deviatedLine) const {
+  for (auto const& deviatedLine: m_deviatedLines) {
+    if (deviatedLine == p_deviatedLine) {
+      return true;
+    }
+  }
+
+  return false;
+}
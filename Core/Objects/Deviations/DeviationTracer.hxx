@@ -0,0 +1,39 @@
+#ifndef DEVIATIONTRACER_HXX
+#define DEVIATIONTRACER_HXX
+
+#include "Core/Geometry/Segment.hxx"
+
+#include <vector>
+
+class Object;
+class Deviation;
+
+// Follows a line through mirrors and portals. Deviations are compared by hit distance only,
+// the winner alone builds its deviated lines, and traced lines are kept in a buffer reused
+// from one trace to the next: the live preview allocates once per bounce, for the winner's lines.
+class DeviationTracer {
+
+public:
+  // A line bouncing between facing deviations never leaves them: tracing stops once a
+  // deviated line repeats, or after this many bounces.
+  static constexpr unsigned int MaxBouncesCount = 64;
+
+  DeviationTracer();
+
+  void SetDeviationsList(std::vector<Object*> const& p_deviationsList);
+  void AddDeviation(Object* p_deviation);
+
+  // Pieces of p_line up to each deviation followed by the last deviated line,
+  // every deviated line being as long as the line's part before its first deviation.
+  std::vector<ppxl::Segment> const& Trace(ppxl::Segment const& p_line);
+  Deviation const* GetNearestDeviation(ppxl::Segment const& p_line) const;
+
+private:
+  bool IsRepeated(ppxl::Segment const& p_deviatedLine) const;
+
+  std::vector<Deviation const*> m_deviationsList;
+  std::vector<ppxl::Segment> m_lines;
+  std::vector<ppxl::Segment> m_deviatedLines;
+};
+
+#endif
@@ -24,7 +24,6 @@ std::string Mirror::GetName() const {
 }
 
 bool Mirror::Intersect(const ppxl::Point& p_point, double p_tolerance) const {
-  qDebug() << "INTERSECT";
   return m_line.PointIsOnSegment(p_point, p_tolerance);
 }
 
@@ -74,6 +73,15 @@ std::vector<ppxl::Segment> Mirror::DeviateLine(ppxl::Segment const& p_line) cons
   return deviatedLines;
 }
 
+bool Mirror::ComputeHitDistance(ppxl::Segment const& p_line, double& p_distance) const {
+  if (m_line.ComputeIntersection(p_line) != ppxl::Segment::Regular) {
+    return false;
+  }
+
+  p_distance = ppxl::Segment(p_line.GetA(), ppxl::Segment::IntersectionPoint(m_line, p_line)).Length();
+  return true;
+}
+
 void Mirror::MoveControlPoint(const ppxl::Point& p_point, Object::ControlPointType p_controlPointType) {
   auto endPoint = p_point;
 
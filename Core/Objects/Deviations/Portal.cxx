@@ -74,6 +74,16 @@ std::vector<ppxl::Segment> Portal::DeviateLine(ppxl::Segment const& p_line) cons
   return deviatedLines;
 }
 
+bool Portal::ComputeHitDistance(ppxl::Segment const& p_line, double& p_distance) const {
+  ppxl::Segment const& in = (m_out.ComputeIntersection(p_line) == ppxl::Segment::Regular) ? m_out : m_in;
+  if (in.ComputeIntersection(p_line) != ppxl::Segment::Regular) {
+    return false;
+  }
+
+  p_distance = ppxl::Segment(p_line.GetA(), ppxl::Segment::IntersectionPoint(in, p_line)).Length();
+  return true;
+}
+
 std::vector<ppxl::Segment> Portal::DeviateLine2(ppxl::Segment const& p_line) const {
   std::vector<ppxl::Segment> deviatedLines;
 
@@ -26,6 +26,7 @@ public:
   std::string GetName() const override;
   bool Intersect(ppxl::Point const& p_point, double p_tolerence = DBL_EPSILON) const override;
   std::vector<ppxl::Segment> DeviateLine(ppxl::Segment const& p_line) const override;
+  bool ComputeHitDistance(ppxl::Segment const& p_line, double& p_distance) const override;
   std::vector<ppxl::Segment> DeviateLine2(ppxl::Segment const& p_line) const;
 
   void MoveControlPoint(ppxl::Point const& p_point, ControlPointType p_controlPointType) override;
@@ -3,6 +3,7 @@
 
 #include "Core/Objects/Object.hxx"
 #include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/BoundingBox.hxx"
 
 class Obstacle: public Object {
 
@@ -11,6 +12,7 @@ public:
   ~Obstacle() override;
 
   virtual bool Crossing(ppxl::Segment const& p_line) const = 0;
+  virtual ppxl::BoundingBox GetBoundingBox() const = 0;
 };
 
 #endif
@@ -32,6 +32,10 @@ bool OneWay::Crossing(ppxl::Segment const& p_line) const {
   return false;
 }
 
+ppxl::BoundingBox OneWay::GetBoundingBox() const {
+  return ppxl::BoundingBox::FromSegment(m_line);
+}
+
 void OneWay::MoveControlPoint(const ppxl::Point& p_point, Object::ControlPointType p_controlPointType) {
   auto endPoint = p_point;
 
@@ -30,10 +30,15 @@ bool Tape::Intersect(const ppxl::Point& p_point, double p_tolerence) const
 }
 
 bool Tape::Crossing(ppxl::Segment const& p_line) const {
-  auto edges = GetTapeEdges();
-
-  for (auto const& edge: edges) {
-    if (edge.ComputeIntersection(p_line) == ppxl::Segment::Regular) {
+  double const ringX[4] = {m_x1, m_x2, m_x2, m_x1};
+  double const ringY[4] = {m_y1, m_y1, m_y2, m_y2};
+  ppxl::Segment::Intersection intersections[4];
+  ppxl::Segment::ComputeIntersections(
+    p_line.GetA().GetX(), p_line.GetA().GetY(), p_line.GetB().GetX(), p_line.GetB().GetY(),
+    ringX, ringY, 4, intersections);
+
+  for (auto intersection: intersections) {
+    if (intersection == ppxl::Segment::Regular) {
       return true;
     }
   }
@@ -41,6 +46,10 @@ bool Tape::Crossing(ppxl::Segment const& p_line) const {
   return false;
 }
 
+ppxl::BoundingBox Tape::GetBoundingBox() const {
+  return ppxl::BoundingBox(GetXmin(), GetYmin(), GetXmax(), GetYmax());
+}
+
 void Tape::MoveControlPoint(const ppxl::Point& p_point, Object::ControlPointType p_controlPointType) {
   auto newX = p_point.GetX();
   auto newY = p_point.GetY();
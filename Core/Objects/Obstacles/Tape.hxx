@@ -29,6 +29,7 @@ public:
   std::string GetName() const override;
   bool Intersect(ppxl::Point const& p_point, double p_tolerence = DBL_EPSILON) const override;
   bool Crossing(ppxl::Segment const& p_line) const override;
+  ppxl::BoundingBox GetBoundingBox() const override;
 
   void MoveControlPoint(ppxl::Point const& p_point, ControlPointType p_controlPointType) override;
   void Translate(ppxl::Vector const& p_direction) override;
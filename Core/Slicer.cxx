@@ -2,23 +2,51 @@
 
 #include "Core/Geometry/Vector.hxx"
 #include "Core/Objects/Object.hxx"
-#include "Core/Objects/Deviations/Deviation.hxx"
 #include "Core/Objects/Obstacles/Obstacle.hxx"
+#include "Core/Trace.hxx"
 
 #include <cmath>
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+namespace {
+
+// Boxes are inflated so that the tolerances of ppxl::Segment::ComputeIntersection
+// never classify a crossing with an edge whose box the line does not touch.
+constexpr double IndexMargin = 1e-6;
+
+}
 
 Slicer::Slicer():
   m_startPoint(),
-  m_orientedAreaTotal(0.) {
+  m_orientedAreaTotal(0.),
+  m_nextPolygonId(0) {
 }
 
 Slicer::~Slicer() = default;
 
+void Slicer::SetPolygonsList(std::vector<ppxl::Polygon> const& p_polygonsList) {
+  m_polygonsList = p_polygonsList;
+  m_polygonsIds.clear();
+  m_polygonsBoxes.clear();
+  for (auto const& polygon: m_polygonsList) {
+    m_polygonsIds.push_back(m_nextPolygonId++);
+    m_polygonsBoxes.push_back(polygon.GetBoundingBox().Inflated(IndexMargin));
+  }
+  m_polygonsIndex.Build(m_polygonsBoxes);
+}
+
+void Slicer::SetObstaclesList(std::vector<Object*> const& p_obstaclesList) {
+  m_obstaclesList = p_obstaclesList;
+  UpdateObstaclesIndex();
+}
+
 void Slicer::SeObjectsList(std::vector<Object*> const& p_objectsList) {
   for (auto object: p_objectsList) {
     switch(object->GetCategoryType()) {
     case Object::eDeviation: {
-      m_deviationsList.push_back(object);
+      m_deviationTracer.AddDeviation(object);
       break;
     } case Object::eMutable: {
       m_mutablesList.push_back(object);
@@ -30,38 +58,118 @@ void Slicer::SeObjectsList(std::vector<Object*> const& p_objectsList) {
       break;
     }
   }
+
+  UpdateObstaclesIndex();
 }
 
+void Slicer::UpdateObstaclesIndex() {
+  std::vector<ppxl::BoundingBox> obstaclesBoxes;
+  for (auto const* obstacle: m_obstaclesList) {
+    obstaclesBoxes.push_back(static_cast<Obstacle const*>(obstacle)->GetBoundingBox().Inflated(IndexMargin));
+  }
+  m_obstaclesIndex.Build(obstaclesBoxes);
+}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// SLICING ALGORITHM
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool Slicer::SliceIt(ppxl::Point const& p_endPoint) {
-  auto lines = ComputeSlicingLines(p_endPoint);
+  PolygonsChangeSet changeSet;
+  return SliceIt(p_endPoint, changeSet);
+}
+
+bool Slicer::SliceIt(ppxl::Point const& p_endPoint, PolygonsChangeSet& p_changeSet) {
+  p_changeSet.m_removedIds.clear();
+  p_changeSet.m_addedIds.clear();
+  p_changeSet.m_addedPolygons.clear();
+
+  auto const& lines = ComputeSlicingLines(p_endPoint);
 
   if (ComputeLinesType(lines) == eGoodCrossing) {
-    std::vector<ppxl::Polygon> newPolygonList;
     for (ppxl::Segment const& line: lines) {
       // Browse every polygon and slice it!
-      ComputeNewPolygonList(newPolygonList, line);
-      m_polygonsList = newPolygonList;
-      newPolygonList.clear();
+      SliceAlong(line, p_changeSet);
     }
+    PPXL_TRACE(eSlicer, "Slice along " << lines.size() << " lines: " << p_changeSet.m_removedIds.size() << " polygons removed, "
+      << p_changeSet.m_addedIds.size() << " added");
     return true;
   }
 
   return false;
 }
 
-std::vector<ppxl::Segment> Slicer::ComputeSlicingLines(ppxl::Point const& p_endPoint) {
-  std::vector<ppxl::Segment> lines;
+void Slicer::SliceAlong(ppxl::Segment const& p_line, PolygonsChangeSet& p_changeSet) {
+  std::vector<ppxl::SpatialIndex::ItemIndex> candidates;
+  m_polygonsIndex.Query(p_line, candidates);
+  std::vector<bool> reached(m_polygonsList.size(), false);
+  for (auto candidate: candidates) {
+    reached[candidate] = true;
+  }
+
+  // Untouched polygons are moved over with their id and box, cut ones are replaced by their pieces
+  std::vector<ppxl::Polygon> polygonsList;
+  std::vector<PolygonId> polygonsIds;
+  std::vector<ppxl::BoundingBox> polygonsBoxes;
+  polygonsList.reserve(m_polygonsList.size());
+  polygonsIds.reserve(m_polygonsList.size());
+  polygonsBoxes.reserve(m_polygonsList.size());
+
+  std::vector<ppxl::Polygon> pieces;
+  for (unsigned int k = 0; k < m_polygonsList.size(); ++k) {
+    ppxl::Polygon& polygon = m_polygonsList[k];
+
+    pieces.clear();
+    bool kept = false;
+    if (reached[k]) {
+      ComputeNewPolygonList(pieces, polygon, p_line);
+      kept = (pieces.size() == 1 && pieces.front().GetVertices() == polygon.GetVertices());
+    } else {
+      kept = IsLargeEnough(polygon);
+    }
+
+    if (kept) {
+      polygonsList.push_back(std::move(polygon));
+      polygonsIds.push_back(m_polygonsIds[k]);
+      polygonsBoxes.push_back(m_polygonsBoxes[k]);
+      continue;
+    }
+
+    // A piece added earlier in the same slice is just forgotten
+    auto added = std::find(p_changeSet.m_addedIds.begin(), p_changeSet.m_addedIds.end(), m_polygonsIds[k]);
+    if (added != p_changeSet.m_addedIds.end()) {
+      auto position = added - p_changeSet.m_addedIds.begin();
+      p_changeSet.m_addedIds.erase(added);
+      p_changeSet.m_addedPolygons.erase(p_changeSet.m_addedPolygons.begin() + position);
+    } else {
+      p_changeSet.m_removedIds.push_back(m_polygonsIds[k]);
+    }
+
+    for (auto& piece: pieces) {
+      PolygonId id = m_nextPolygonId++;
+      p_changeSet.m_addedIds.push_back(id);
+      p_changeSet.m_addedPolygons.push_back(piece);
+      polygonsIds.push_back(id);
+      polygonsBoxes.push_back(piece.GetBoundingBox().Inflated(IndexMargin));
+      polygonsList.push_back(std::move(piece));
+    }
+  }
 
-  ppxl::Segment line(m_startPoint, p_endPoint);
-  int k = 0;
-  ComputeDeviatedLines(-1, line, lines, k, nullptr);
+  m_polygonsList.swap(polygonsList);
+  m_polygonsIds.swap(polygonsIds);
+  m_polygonsBoxes.swap(polygonsBoxes);
+  m_polygonsIndex.Build(m_polygonsBoxes);
+}
 
-  return lines;
+bool Slicer::IsLargeEnough(ppxl::Polygon const& p_polygon) const {
+  // Don't keep a polygon if its area is less than 0.1% of the total area.
+  // This allows users to draw several lines that pass near a point,
+  // but not exactly on this point, since it's quite difficult to achieve.
+  return std::round(10.0*p_polygon.OrientedArea() * 100.0 / m_orientedAreaTotal)/10.0 >= 0.1;
+}
+
+std::vector<ppxl::Segment> const& Slicer::ComputeSlicingLines(ppxl::Point const& p_endPoint) {
+  return m_deviationTracer.Trace(ppxl::Segment(m_startPoint, p_endPoint));
 }
 
 Slicer::LineType Slicer::ComputeLinesType(std::vector<ppxl::Segment> const& p_lines) const {
@@ -69,9 +177,18 @@ Slicer::LineType Slicer::ComputeLinesType(std::vector<ppxl::Segment> const& p_li
   bool goodCrossing = false;
   bool badCrossing = false;
 
-  auto polygonList = m_polygonsList;
+  std::vector<ppxl::SpatialIndex::ItemIndex> candidates;
   for (ppxl::Segment const& line: p_lines) {
-    for (auto const& polygon: polygonList) {
+    candidates.clear();
+    m_polygonsIndex.Query(line, candidates);
+
+    // The line neither crosses nor starts inside the polygons it does not reach
+    if (candidates.size() < m_polygonsList.size()) {
+      noCrossing = true;
+    }
+
+    for (auto candidate: candidates) {
+      ppxl::Polygon const& polygon = m_polygonsList[candidate];
       if (!polygon.IsCrossing(line) && !polygon.IsPointInside(line.GetA())) {
         noCrossing = true;
       } else if (polygon.IsGoodSegment(line)) {
@@ -81,8 +198,10 @@ Slicer::LineType Slicer::ComputeLinesType(std::vector<ppxl::Segment> const& p_li
       }
     }
 
-    for (auto const* obstacle: m_obstaclesList) {
-      if (static_cast<Obstacle const*>(obstacle)->Crossing(line)) {
+    candidates.clear();
+    m_obstaclesIndex.Query(line, candidates);
+    for (auto candidate: candidates) {
+      if (static_cast<Obstacle const*>(m_obstaclesList[candidate])->Crossing(line)) {
         badCrossing = true;
       }
     }
@@ -99,153 +218,155 @@ Slicer::LineType Slicer::ComputeLinesType(std::vector<ppxl::Segment> const& p_li
   }
 }
 
-void Slicer::ComputeDeviatedLines(double firstLineLength, ppxl::Segment const& line, std::vector<ppxl::Segment>& lines, int& p_counter, Deviation** p_lastDeviation) const {
-  Deviation* nearestDeviation = GetNearestDeviation(line);
-
-  if (nearestDeviation && (p_counter == 0 || nearestDeviation != *p_lastDeviation)) {
-    std::vector<ppxl::Segment> deviateLines = nearestDeviation->DeviateLine(line);
-    // Init firstLineLength
-    if (firstLineLength < 0.) {
-      firstLineLength = deviateLines.at(0).Length();
-    }
-
-    // At least two lines have to be here: the line drawn and its deviation
-    assert(deviateLines.size() > 1);
-
-    // Erase previous line, since it goes through current mirror
-    if (lines.size() > 1) {
-      lines.erase(lines.end()-1);
-    }
-
-    // Make the deviated line's length the same as the firstLine one
-    ppxl::Segment deviateLine = deviateLines.at(1);
-    ppxl::Point A = deviateLine.GetA();
-    ppxl::Point B = deviateLine.GetB();
-    ppxl::Vector lu = firstLineLength * ppxl::Vector(A, B).Normalize();
-    ppxl::Point BB(lu.GetX(), lu.GetY());
-    deviateLine.SetB(A + BB);
-
-    // Push line and its reflexion
-    lines.push_back(deviateLines.at(0));
-    lines.push_back(deviateLine);
-
-    if (p_counter == 0)
-      qDebug() << "\n######";
-    qDebug() << p_counter << lines;
-
-    ComputeDeviatedLines(firstLineLength, deviateLine, lines, ++p_counter, &nearestDeviation);
-  } else {
-    if (lines.size() > 1) {
-      lines.erase(lines.end()-1);
-    }
-    lines.push_back(line);
+void Slicer::ComputeNewPolygonList(std::vector<ppxl::Polygon>& p_newPolygonList, ppxl::Polygon const& p_polygon, ppxl::Segment const& p_line) const {
+  auto& vertexPool = m_scratch.m_vertexPool;
+  auto& intersections = m_scratch.m_intersections;
+  auto& otherBounds = m_scratch.m_otherBounds;
+  GetVerticesAndIntersections(p_line, p_polygon, vertexPool, intersections, otherBounds);
+
+  // Vertices are linked in a ring. Once a vertex belongs to a new polygon, it is
+  // unlinked from the ring; intersections are shared by two polygons and stay linked.
+  auto ringSize = static_cast<VertexIndex>(vertexPool.size());
+  auto& previousVertices = m_scratch.m_previousVertices;
+  auto& nextVertices = m_scratch.m_nextVertices;
+  previousVertices.resize(ringSize);
+  nextVertices.resize(ringSize);
+  for (VertexIndex k = 0; k < ringSize; ++k) {
+    previousVertices[k] = (k+ringSize-1)%ringSize;
+    nextVertices[k] = (k+1)%ringSize;
   }
-}
-
-Deviation* Slicer::GetNearestDeviation(ppxl::Segment const& line) const {
-  double minDist = std::numeric_limits<double>::infinity();
-  Deviation* nearestDeviation = nullptr;
-
-  for (auto deviation: m_deviationsList) {
-    auto deviationCast = static_cast<Deviation*>(deviation);
-    std::vector<ppxl::Segment> deviateLines = deviationCast->DeviateLine(line);
-    // If there is at least one reflected line
-    if (deviateLines.size() > 1) {
-      if (deviateLines.at(0).Length() < minDist) {
-        minDist = deviateLines.at(0).Length();
-        nearestDeviation = deviationCast;
+  auto baseVerticesCount = ringSize - intersections.size();
+
+  // An intersection joins a new polygon unless a vertex at the same place already did. The pool
+  // vertices at the place of each cutting bound are listed once, found by abscissa, and each
+  // vertex keeps the number of the last new polygon it joined.
+  auto& byAbscissa = m_scratch.m_byAbscissa;
+  byAbscissa.resize(ringSize);
+  std::iota(byAbscissa.begin(), byAbscissa.end(), 0);
+  std::sort(byAbscissa.begin(), byAbscissa.end(), [&vertexPool](VertexIndex p_index1, VertexIndex p_index2) {
+    return vertexPool[p_index1].GetX() < vertexPool[p_index2].GetX();
+  });
+  auto& samePlaceVertices = m_scratch.m_samePlaceVertices;
+  auto& samePlaceRanges = m_scratch.m_samePlaceRanges;
+  samePlaceVertices.clear();
+  samePlaceRanges.resize(ringSize);
+  for (auto bound: intersections) {
+    double x = vertexPool[bound].GetX();
+    auto it = std::partition_point(byAbscissa.cbegin(), byAbscissa.cend(), [&vertexPool, x](VertexIndex p_index) {
+      return x - vertexPool[p_index].GetX() >= DBL_EPSILON;
+    });
+    samePlaceRanges[bound].first = static_cast<unsigned int>(samePlaceVertices.size());
+    for (; it != byAbscissa.cend() && vertexPool[*it].GetX() - x < DBL_EPSILON; ++it) {
+      if (vertexPool[*it] == vertexPool[bound]) {
+        samePlaceVertices.push_back(*it);
       }
     }
+    samePlaceRanges[bound].second = static_cast<unsigned int>(samePlaceVertices.size());
   }
+  auto& joinedPolygons = m_scratch.m_joinedPolygons;
+  joinedPolygons.assign(ringSize, 0);
+  unsigned int polygonNumber = 0;
+
+  auto& newVertices = m_scratch.m_newVertices;
+  newVertices.clear();
+  VertexIndex start = 0;
+  while (baseVerticesCount > 0) {
+    ++polygonNumber;
+    // Unlinked vertices keep their next vertex, follow them to the first one still in the ring.
+    while (previousVertices[start] == InvalidVertexIndex) {
+      start = nextVertices[start];
+    }
+    // We really don't want the first point to be an intersection. Trust me.
+    while (otherBounds[start] != InvalidVertexIndex) {
+      start = nextVertices[start];
+    }
 
-  return nearestDeviation;
-}
+    // Position of a vertex along the ring, counted from the start of the new polygon.
+    auto offset = [start, ringSize](VertexIndex p_vertex) {
+      return (p_vertex+ringSize-start)%ringSize;
+    };
+
+    VertexIndex currVertex = start;
+    while (true) {
+      VertexIndex nextVertex = nextVertices[currVertex];
+      ppxl::Point const& currPoint = vertexPool[currVertex];
+      if (otherBounds[currVertex] == InvalidVertexIndex) {
+        newVertices.push_back(currPoint);
+        joinedPolygons[currVertex] = polygonNumber;
+        nextVertices[previousVertices[currVertex]] = nextVertex;
+        previousVertices[nextVertex] = previousVertices[currVertex];
+        previousVertices[currVertex] = InvalidVertexIndex;
+        --baseVerticesCount;
+      } else {
+        // If the intersection is not equal to a point of the new polygon, we add it
+        auto samePlaceBegin = samePlaceVertices.cbegin() + samePlaceRanges[currVertex].first;
+        auto samePlaceEnd = samePlaceVertices.cbegin() + samePlaceRanges[currVertex].second;
+        bool joined = std::any_of(samePlaceBegin, samePlaceEnd, [&joinedPolygons, polygonNumber](VertexIndex p_vertex) {
+          return joinedPolygons[p_vertex] == polygonNumber;
+        });
+        if (newVertices.size() > 0 && !joined) {
+          newVertices.push_back(currPoint);
+          joinedPolygons[currVertex] = polygonNumber;
+        }
 
-void Slicer::ComputeNewPolygonList(std::vector<ppxl::Polygon>& p_newPolygonList, ppxl::Segment const& p_line) const {
-  for (auto const& polygon: m_polygonsList) {
-    std::vector<ppxl::Point*> globalVertices;
-    std::vector<ppxl::Point*> intersections;
-    GetVerticesAndIntersections(p_line, polygon, globalVertices, intersections);
-
-    std::vector<ppxl::Point> newVertices;
-    std::vector<std::pair<ppxl::Point*, ppxl::Point*>> cuttingSegments = GetCuttingSegments(intersections);
-
-    while (StillHasBaseVertices(globalVertices, intersections)) {
-      // We really don't want the first point to be an intersection. Trust me.
-      ppxl::Point* p = globalVertices.at(0);
-      while (std::find(intersections.begin(), intersections.end(), p) != intersections.end()) {
-        globalVertices.erase(globalVertices.begin());
-        globalVertices.push_back(p);
-        p = globalVertices.at(0);
-      }
-      std::vector<ppxl::Point*> globalVerticesCopy(globalVertices);
-
-      bool lookingForOtherBound = false;
-      ppxl::Point* otherBound = nullptr;
-      for (ppxl::Point* currVerrtex: globalVerticesCopy) {
-        if (lookingForOtherBound) {
-          if (otherBound == currVerrtex) {
-            newVertices.push_back(*currVerrtex);
-            lookingForOtherBound = false;
-          }
-        } else {
-          if (std::find(intersections.begin(), intersections.end(), currVerrtex) != intersections.end()) {
-            // If the intersection is not equal to the last point, we add it
-            if (newVertices.size() > 0 && (std::find(newVertices.begin(), newVertices.end(), *currVerrtex) == newVertices.end())) {
-              newVertices.push_back(*currVerrtex);
-            }
-            otherBound = GetOtherBound(currVerrtex, cuttingSegments);
-            lookingForOtherBound = true;
-          } else {
-            newVertices.push_back(*currVerrtex);
-            auto it = std::find(globalVertices.begin(), globalVertices.end(), currVerrtex);
-            assert(it != globalVertices.end());
-            globalVertices.erase(it);
-          }
+        // Jump along the cutting segment. If its other bound has already been
+        // browsed, the remaining vertices belong to other polygons.
+        VertexIndex otherBound = otherBounds[currVertex];
+        if (offset(otherBound) < offset(currVertex)) {
+          break;
         }
+        newVertices.push_back(vertexPool[otherBound]);
+        joinedPolygons[otherBound] = polygonNumber;
+        currVertex = otherBound;
+        nextVertex = nextVertices[otherBound];
       }
-      globalVerticesCopy.clear();
-      globalVerticesCopy = globalVertices;
-
-      ppxl::Polygon newPolygon(newVertices);
-      // Don't add the new polygon if its area is less than 0.1% of the total area.
-      // This allows users to draw several lines that pass near a point,
-      // but not exactly on this point, since it's quite difficult to achieve.
-      if (std::round(10.0*newPolygon.OrientedArea() * 100.0 / m_orientedAreaTotal)/10.0 >= 0.1) {
-        p_newPolygonList.push_back(newPolygon);
+
+      // Stop once the whole ring has been browsed
+      if (offset(nextVertex) <= offset(currVertex)) {
+        break;
       }
+      currVertex = nextVertex;
+    }
 
-      newVertices.clear();
+    ppxl::Polygon newPolygon(newVertices);
+    if (IsLargeEnough(newPolygon)) {
+      p_newPolygonList.push_back(newPolygon);
     }
+
+    newVertices.clear();
   }
 }
 
-void Slicer::GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon,
-  std::vector<ppxl::Point*>& globalVertices, std::vector<ppxl::Point*>& intersections) const {
+void Slicer::GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon, std::vector<ppxl::Point>& vertexPool,
+  std::vector<VertexIndex>& intersections, std::vector<VertexIndex>& otherBounds) const {
 
-  std::vector<ppxl::Point> baseVertices = polygon.GetVertices();
+  std::vector<ppxl::Point> const& baseVertices = polygon.GetVertices();
+
+  vertexPool.clear();
+  intersections.clear();
+  // Each edge adds at most its first bound and one intersection.
+  vertexPool.reserve(2*baseVertices.size());
+
+  auto& intersectionTypes = m_scratch.m_intersectionTypes;
+  polygon.ComputeIntersections(line, intersectionTypes);
 
   for (unsigned int k = 0; k < baseVertices.size(); ++k) {
-    auto A = new ppxl::Point(baseVertices.at(k));
-    auto B = new ppxl::Point(baseVertices.at((k+1)%baseVertices.size()));
-    ppxl::Segment AB(*A, *B);
+    ppxl::Point const& A = baseVertices.at(k);
+    ppxl::Point const& B = baseVertices.at((k+1)%baseVertices.size());
 
-    globalVertices.push_back(A);
+    vertexPool.push_back(A);
 
-    ppxl::Segment::Intersection intersectionType = AB.ComputeIntersection(line);
-    switch (intersectionType) {
+    switch (intersectionTypes.at(k)) {
     case ppxl::Segment::Regular:
     {
-      auto intersection = new ppxl::Point(ppxl::Segment::IntersectionPoint(AB, line));
-      globalVertices.push_back(intersection);
-      intersections.push_back(intersection);
+      intersections.push_back(static_cast<VertexIndex>(vertexPool.size()));
+      vertexPool.push_back(ppxl::Segment::IntersectionPoint(ppxl::Segment(A, B), line));
       break;
     }
     case ppxl::Segment::FirstVertexRegular:
     {
-      auto intersection = new ppxl::Point(baseVertices.at(k));
-      globalVertices.push_back(intersection);
-      intersections.push_back(intersection);
+      intersections.push_back(static_cast<VertexIndex>(vertexPool.size()));
+      vertexPool.push_back(A);
       break;
     }
     default:
@@ -253,30 +374,36 @@ void Slicer::GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygo
     }
   }
 
-  std::sort(intersections.begin(), intersections.end(), Slicer::ComparePoints);
+  std::sort(intersections.begin(), intersections.end(), [&vertexPool](VertexIndex p_index1, VertexIndex p_index2) {
+    return vertexPool.at(p_index1) < vertexPool.at(p_index2);
+  });
 
-  CleanIntersections(polygon, intersections);
+  CleanIntersections(polygon, vertexPool, intersections);
+
+  otherBounds.assign(vertexPool.size(), InvalidVertexIndex);
+  PairCuttingBounds(intersections, otherBounds);
 }
 
-void Slicer::CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point*>& intersections) const {
+void Slicer::CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point> const& vertexPool, std::vector<VertexIndex>& intersections) const {
   if (intersections.size() < 2) {
     intersections.clear();
     return;
   }
 
-  std::vector<ppxl::Point*> realIntersection;
+  // Kept intersections are written over the browsed ones
+  unsigned int realIntersectionsCount = 0;
   bool inside = false;
 
   for (unsigned int k = 0; k < intersections.size()-1; ++k) {
-    ppxl::Segment AB(*intersections.at(k), *intersections.at(k+1));
-    if (polygon.IsPointInside(AB.GetCenter())) {
+    ppxl::Point center = ppxl::Point::Middle(vertexPool.at(intersections.at(k)), vertexPool.at(intersections.at(k+1)));
+    if (polygon.IsPointInside(center)) {
       if (!inside) {
-        realIntersection.push_back(intersections.at(k));
+        intersections[realIntersectionsCount++] = intersections.at(k);
         inside = true;
       }
-    } else if (!polygon.IsPointInside(AB.GetCenter())) {
+    } else {
       if (inside) {
-        realIntersection.push_back(intersections.at(k));
+        intersections[realIntersectionsCount++] = intersections.at(k);
         inside = false;
       }
     }
@@ -285,48 +412,20 @@ void Slicer::CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::
   // Handle last vertex
   if (inside)
   {
-    realIntersection.push_back(intersections.at(intersections.size()-1));
+    intersections[realIntersectionsCount++] = intersections.at(intersections.size()-1);
   }
 
-  intersections.clear();
-  intersections = realIntersection;
+  intersections.resize(realIntersectionsCount);
 }
 
-std::vector<std::pair<ppxl::Point*, ppxl::Point*>> Slicer::GetCuttingSegments(std::vector<ppxl::Point*> const& intersections) const {
+void Slicer::PairCuttingBounds(std::vector<VertexIndex> const& intersections, std::vector<VertexIndex>& otherBounds) const {
   assert(intersections.size()%2 == 0);
 
-  std::vector<std::pair<ppxl::Point*, ppxl::Point*>> cuttingSegments;
-  if (intersections.size() == 0) {
-    return cuttingSegments;
-  }
-
-  for (unsigned int k = 0; k < intersections.size()-1; k += 2) {
-    ppxl::Segment AB(*intersections.at(k), *intersections.at(k+1));
-    cuttingSegments.push_back(std::pair<ppxl::Point*, ppxl::Point*>(intersections.at(k), intersections.at((k+1)%intersections.size())));
+  // Sorted intersections go by pair: each pair bounds a cutting segment inside the polygon.
+  for (unsigned int k = 0; k+1 < intersections.size(); k += 2) {
+    otherBounds.at(intersections.at(k)) = intersections.at(k+1);
+    otherBounds.at(intersections.at(k+1)) = intersections.at(k);
   }
-  return cuttingSegments;
-}
-
-bool Slicer::StillHasBaseVertices(std::vector<ppxl::Point*> const& globalVertices, std::vector<ppxl::Point*> const& intersections) const {
-  for (ppxl::Point* p: globalVertices) {
-    if (std::find(intersections.begin(), intersections.end(), p) == intersections.end()) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-ppxl::Point* Slicer::GetOtherBound(ppxl::Point const* intersection, std::vector<std::pair<ppxl::Point*, ppxl::Point*>> const& cuttingSegments) const {
-  for (std::pair<ppxl::Point*, ppxl::Point*> const& cuttingSegment: cuttingSegments) {
-    if (cuttingSegment.first == intersection) {
-      return cuttingSegment.second;
-    } else if (cuttingSegment.second == intersection) {
-      return cuttingSegment.first;
-    }
-  }
-
-  return nullptr;
 }
 
 
@@ -341,13 +440,13 @@ std::vector<double> Slicer::ComputeAreas(double& p_minArea, double& p_maxArea) {
 
   double areaCumul = 0.;
   for (unsigned int row = 0; row < m_polygonsList.size(); ++row) {
-    auto polygon = m_polygonsList.at(row);
+    auto const& polygon = m_polygonsList.at(row);
     double currArea = 0.;
 
     if (row == m_polygonsList.size()-1) {
       currArea = 100. - areaCumul;
     } else {
-      currArea = qRound(10.*polygon.OrientedArea() * 100. / m_orientedAreaTotal) / 10.;
+      currArea = std::round(10.*polygon.OrientedArea() * 100. / m_orientedAreaTotal) / 10.;
       areaCumul += currArea;
     }
 
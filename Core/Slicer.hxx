@@ -2,11 +2,14 @@
 #define SLICER_HXX
 
 #include "Core/Geometry/Polygon.hxx"
+#include "Core/Geometry/SpatialIndex.hxx"
+#include "Core/Objects/Deviations/DeviationTracer.hxx"
 
 #include <vector>
+#include <limits>
+#include <utility>
 
 class Object;
-class Deviation;
 
 class Slicer {
 
@@ -18,33 +21,48 @@ public:
     eUnknownCrossing
   };
 
+  // Vertices and intersections of the polygon being sliced live in a pool owned by
+  // the slicer and are referenced by their position in that pool,
+  // which is also their position when browsing the polygon's edges.
+  using VertexIndex = unsigned int;
+  static constexpr VertexIndex InvalidVertexIndex = std::numeric_limits<VertexIndex>::max();
+
+  // Polygons are referred to by ids that stay valid until a line cuts or drops the polygon.
+  using PolygonId = unsigned int;
+
+  // What a slice did to the polygons, so that consumers apply it instead of reloading them all.
+  // Pieces cut again by a later deviated line of the same slice are not reported.
+  struct PolygonsChangeSet {
+    std::vector<PolygonId> m_removedIds;
+    std::vector<PolygonId> m_addedIds;
+    std::vector<ppxl::Polygon> m_addedPolygons;
+  };
+
   Slicer();
   virtual ~Slicer();
 
   /// INLINE GETTERS AND SETTERS
-  inline void SetPolygonsList(std::vector<ppxl::Polygon> const& p_polygonsList) { m_polygonsList = p_polygonsList; }
-  inline std::vector<ppxl::Polygon> GetPolygonsList() { return m_polygonsList; }
-  inline void SetDeviationsList(std::vector<Object*> p_deviationsList) { m_deviationsList = p_deviationsList; }
+  void SetPolygonsList(std::vector<ppxl::Polygon> const& p_polygonsList);
+  inline std::vector<ppxl::Polygon> const& GetPolygonsList() const { return m_polygonsList; }
+  inline std::vector<PolygonId> const& GetPolygonsIds() const { return m_polygonsIds; }
+  inline void SetDeviationsList(std::vector<Object*> const& p_deviationsList) { m_deviationTracer.SetDeviationsList(p_deviationsList); }
   inline void SetMutablesList(std::vector<Object*> p_mutablesList) { m_mutablesList = p_mutablesList; }
-  inline void SetObstaclesList(std::vector<Object*> p_obstaclesList) { m_obstaclesList = p_obstaclesList; }
+  void SetObstaclesList(std::vector<Object*> const& p_obstaclesList);
   inline void SetStartPoint(ppxl::Point const& p_startPoint) { m_startPoint = p_startPoint; }
   inline void SetOrientedAreaTotal(double p_orientedAreaTotal) { m_orientedAreaTotal = p_orientedAreaTotal; }
-  static inline bool ComparePoints(const ppxl::Point* A, const ppxl::Point* B) { return *A < *B; }
   void SeObjectsList(std::vector<Object*> const& p_objectsList);
 
   /// SLICING ALGORITHM
   bool SliceIt(ppxl::Point const& p_endPoint);
-  std::vector<ppxl::Segment> ComputeSlicingLines(ppxl::Point const& p_endPoint);
+  bool SliceIt(ppxl::Point const& p_endPoint, PolygonsChangeSet& p_changeSet);
+  // The lines stay valid until the next call
+  std::vector<ppxl::Segment> const& ComputeSlicingLines(ppxl::Point const& p_endPoint);
   LineType ComputeLinesType(std::vector<ppxl::Segment> const& p_lines) const;
-  void ComputeDeviatedLines(double firstLineLength, ppxl::Segment const& line, std::vector<ppxl::Segment>& lines, int& p_counter, Deviation** p_lastDeviation) const;
-  Deviation* GetNearestDeviation(ppxl::Segment const& line) const;
-  void ComputeNewPolygonList(std::vector<ppxl::Polygon>& p_newPolygonList, ppxl::Segment const& p_line) const;
-  void GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon,
-    std::vector<ppxl::Point*>& globalVertices, std::vector<ppxl::Point*>& intersections) const;
-  void CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point*>& intersections) const;
-  std::vector<std::pair<ppxl::Point*, ppxl::Point*>> GetCuttingSegments(std::vector<ppxl::Point*> const& intersections) const;
-  bool StillHasBaseVertices(std::vector<ppxl::Point*> const& verticesGlobal, std::vector<ppxl::Point*> const& intersections) const;
-  ppxl::Point* GetOtherBound(ppxl::Point const* intersection, std::vector<std::pair<ppxl::Point*, ppxl::Point*>> const& cuttingSegments) const;
+  void ComputeNewPolygonList(std::vector<ppxl::Polygon>& p_newPolygonList, ppxl::Polygon const& p_polygon, ppxl::Segment const& p_line) const;
+  void GetVerticesAndIntersections(ppxl::Segment const& line, ppxl::Polygon const& polygon, std::vector<ppxl::Point>& vertexPool,
+    std::vector<VertexIndex>& intersections, std::vector<VertexIndex>& otherBounds) const;
+  void CleanIntersections(ppxl::Polygon const& polygon, std::vector<ppxl::Point> const& vertexPool, std::vector<VertexIndex>& intersections) const;
+  void PairCuttingBounds(std::vector<VertexIndex> const& intersections, std::vector<VertexIndex>& otherBounds) const;
 
   /// AREAS AND BARYCENTERS
   std::vector<double> ComputeAreas(double& p_minArea, double& p_maxArea);
@@ -53,12 +71,43 @@ public:
   void InitTotalOrientedArea();
 
 private:
+  void SliceAlong(ppxl::Segment const& p_line, PolygonsChangeSet& p_changeSet);
+  bool IsLargeEnough(ppxl::Polygon const& p_polygon) const;
+  void UpdateObstaclesIndex();
+
+  // Buffers of ComputeNewPolygonList, cleared between polygons so that slicing
+  // reuses their storage. A copied slicer starts with empty buffers of its own.
+  struct SliceScratch {
+    SliceScratch() = default;
+    SliceScratch(SliceScratch const&) {}
+    SliceScratch& operator=(SliceScratch const&) { return *this; }
+
+    std::vector<ppxl::Point> m_vertexPool;
+    std::vector<VertexIndex> m_intersections;
+    std::vector<VertexIndex> m_otherBounds;
+    std::vector<ppxl::Segment::Intersection> m_intersectionTypes;
+    std::vector<VertexIndex> m_previousVertices;
+    std::vector<VertexIndex> m_nextVertices;
+    std::vector<VertexIndex> m_byAbscissa;
+    std::vector<VertexIndex> m_samePlaceVertices;
+    std::vector<std::pair<unsigned int, unsigned int>> m_samePlaceRanges;
+    std::vector<unsigned int> m_joinedPolygons;
+    std::vector<ppxl::Point> m_newVertices;
+  };
+
   std::vector<ppxl::Polygon> m_polygonsList;
-  std::vector<Object*> m_deviationsList;
+  // Ids and boxes of m_polygonsList in the same order, and hierarchies over polygons and obstacles
+  std::vector<PolygonId> m_polygonsIds;
+  std::vector<ppxl::BoundingBox> m_polygonsBoxes;
+  ppxl::SpatialIndex m_polygonsIndex;
+  ppxl::SpatialIndex m_obstaclesIndex;
+  DeviationTracer m_deviationTracer;
   std::vector<Object*> m_mutablesList;
   std::vector<Object*> m_obstaclesList;
   ppxl::Point m_startPoint;
   double m_orientedAreaTotal;
+  PolygonId m_nextPolygonId;
+  mutable SliceScratch m_scratch;
 };
 
 #endif
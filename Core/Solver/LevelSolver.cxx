@@ -0,0 +1,320 @@
+#include "LevelSolver.hxx"
+
+#include "Core/Geometry/Vector.hxx"
+#include "Core/Objects/Deviations/Mirror.hxx"
+#include "Core/Objects/Deviations/Portal.hxx"
+#include "Core/Trace.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+// Parts smaller than that, in percent of the level, are rounding noise when comparing states
+constexpr double AreaQuantum = 1e-3;
+
+// Clips the infinite line through p_point along p_direction to p_box
+bool ClipLine(ppxl::Point const& p_point, ppxl::Vector const& p_direction, ppxl::BoundingBox const& p_box, ppxl::Segment& p_line) {
+  double tMin = -std::numeric_limits<double>::infinity();
+  double tMax = std::numeric_limits<double>::infinity();
+  auto clip = [&tMin, &tMax](double p_origin, double p_direction, double p_low, double p_high) {
+    if (p_direction == 0.) {
+      return p_low <= p_origin && p_origin <= p_high;
+    }
+    double t1 = (p_low - p_origin)/p_direction;
+    double t2 = (p_high - p_origin)/p_direction;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    return tMin < tMax;
+  };
+
+  if (!clip(p_point.GetX(), p_direction.GetX(), p_box.GetXMin(), p_box.GetXMax())
+   || !clip(p_point.GetY(), p_direction.GetY(), p_box.GetYMin(), p_box.GetYMax())) {
+    return false;
+  }
+
+  p_line = ppxl::Segment(p_point.GetX() + tMin*p_direction.GetX(), p_point.GetY() + tMin*p_direction.GetY(),
+                         p_point.GetX() + tMax*p_direction.GetX(), p_point.GetY() + tMax*p_direction.GetY());
+  return true;
+}
+
+}
+
+LevelSolver::LevelSolver(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Object*> const& p_objectsList, Goals const& p_goals):
+  m_polygonsList(p_polygonsList),
+  m_objectsList(p_objectsList),
+  m_goals(p_goals),
+  m_totalArea(0.),
+  m_candidateLines(),
+  m_statistics() {
+
+  if (m_goals.m_maxGapToWin < 0) {
+    m_goals.m_maxGapToWin = 100;
+  }
+  for (auto const& polygon: m_polygonsList) {
+    m_totalArea += std::abs(polygon.OrientedArea());
+  }
+}
+
+bool LevelSolver::HasValidGoals() const {
+  return m_goals.m_linesGoal > 0 && m_goals.m_partsGoal > 0 && m_totalArea > 0.;
+}
+
+void LevelSolver::ComputeCandidateLines(unsigned int p_boundarySamplesCount) {
+  m_candidateLines.clear();
+
+  // Lines through polygon vertices, and through points along deviations so that cuts bounce on them
+  std::vector<ppxl::Point> vertices;
+  for (auto const& polygon: m_polygonsList) {
+    vertices.insert(vertices.end(), polygon.GetVertices().begin(), polygon.GetVertices().end());
+  }
+  for (auto const* object: m_objectsList) {
+    ppxl::Segment entry;
+    if (object->GetObjectType() == Object::eMirror) {
+      entry = static_cast<Mirror const*>(object)->GetLine();
+    } else if (object->GetObjectType() == Object::ePortal) {
+      entry = static_cast<Portal const*>(object)->GetIn();
+    } else {
+      continue;
+    }
+    for (double t: {0.25, 0.5, 0.75}) {
+      vertices.emplace_back(entry.GetA().GetX() + t*(entry.GetB().GetX() - entry.GetA().GetX()),
+                            entry.GetA().GetY() + t*(entry.GetB().GetY() - entry.GetA().GetY()));
+    }
+  }
+
+  ppxl::BoundingBox levelBox;
+  for (auto const& vertex: vertices) {
+    levelBox.Extend(vertex);
+  }
+  if (levelBox.IsEmpty()) {
+    return;
+  }
+  // Lines start and end away from the polygons, as a player's would
+  double margin = 0.05*std::max(levelBox.GetXMax() - levelBox.GetXMin(), levelBox.GetYMax() - levelBox.GetYMin()) + 1.;
+  ppxl::BoundingBox box = levelBox.Inflated(margin);
+
+  // Endpoints rounded to remove lines found twice
+  std::set<std::tuple<long long, long long, long long, long long>> keys;
+  auto addLine = [this, &keys](ppxl::Segment const& p_line) {
+    auto key = std::make_tuple(std::llround(1e6*p_line.GetA().GetX()), std::llround(1e6*p_line.GetA().GetY()),
+                               std::llround(1e6*p_line.GetB().GetX()), std::llround(1e6*p_line.GetB().GetY()));
+    if (keys.insert(key).second) {
+      m_candidateLines.push_back(p_line);
+    }
+  };
+
+  for (unsigned int a = 0; a < vertices.size(); ++a) {
+    for (unsigned int b = a+1; b < vertices.size(); ++b) {
+      ppxl::Vector direction(vertices[a], vertices[b]);
+      ppxl::Segment line;
+      if (direction.Norm() > 1e-9 && ClipLine(vertices[a], direction, box, line)) {
+        addLine(line);
+      }
+    }
+  }
+
+  // Samples at the middle of p_boundarySamplesCount intervals on each side, counterclockwise
+  std::vector<std::vector<ppxl::Point>> sides(4);
+  for (unsigned int k = 0; k < p_boundarySamplesCount; ++k) {
+    double t = (k + 0.5)/p_boundarySamplesCount;
+    double x = box.GetXMin() + t*(box.GetXMax() - box.GetXMin());
+    double y = box.GetYMin() + t*(box.GetYMax() - box.GetYMin());
+    sides[0].emplace_back(x, box.GetYMin());
+    sides[1].emplace_back(box.GetXMax(), y);
+    sides[2].emplace_back(x, box.GetYMax());
+    sides[3].emplace_back(box.GetXMin(), y);
+  }
+  for (unsigned int sideA = 0; sideA < sides.size(); ++sideA) {
+    for (unsigned int sideB = sideA+1; sideB < sides.size(); ++sideB) {
+      for (auto const& A: sides[sideA]) {
+        for (auto const& B: sides[sideB]) {
+          addLine(ppxl::Segment(A, B));
+        }
+      }
+    }
+  }
+}
+
+void LevelSolver::Evaluate(State& p_state) const {
+  auto const& polygonsList = p_state.m_slicer.GetPolygonsList();
+  p_state.m_areas.clear();
+  for (auto const& polygon: polygonsList) {
+    p_state.m_areas.push_back(100.*std::abs(polygon.OrientedArea())/m_totalArea);
+  }
+  std::sort(p_state.m_areas.begin(), p_state.m_areas.end());
+  p_state.m_gap = p_state.m_areas.empty() ? 0. : p_state.m_areas.back() - p_state.m_areas.front();
+
+  // Each part should end up cut into a whole number of ideal parts
+  double idealArea = 100./m_goals.m_partsGoal;
+  p_state.m_score = 0.;
+  for (double area: p_state.m_areas) {
+    double partsCount = std::max(1., std::round(area/idealArea));
+    p_state.m_score += std::abs(area - partsCount*idealArea);
+  }
+}
+
+bool LevelSolver::IsSolved(State const& p_state) const {
+  return static_cast<int>(p_state.m_areas.size()) == m_goals.m_partsGoal && p_state.m_gap <= m_goals.m_maxGapToWin;
+}
+
+// Parts only get smaller: the final smallest part is at most the current smallest one, while the
+// final largest part is at least the ideal part area.
+bool LevelSolver::IsHopeless(State const& p_state) const {
+  if (static_cast<int>(p_state.m_areas.size()) > m_goals.m_partsGoal) {
+    return true;
+  }
+  double idealArea = 100./m_goals.m_partsGoal;
+  return !p_state.m_areas.empty() && idealArea - p_state.m_areas.front() > m_goals.m_maxGapToWin;
+}
+
+void LevelSolver::Expand(std::vector<State> const& p_states, std::vector<State>& p_children, unsigned int p_threadsCount) {
+  std::atomic<unsigned int> nextState(0);
+  std::atomic<unsigned long> slicesCount(0);
+  std::atomic<unsigned long> goodSlicesCount(0);
+  std::atomic<unsigned long> prunedStatesCount(0);
+  std::mutex childrenMutex;
+
+  auto expandStates = [&]() {
+    std::vector<State> children;
+    Slicer::PolygonsChangeSet changeSet;
+    for (unsigned int index = nextState++; index < p_states.size(); index = nextState++) {
+      State const& state = p_states[index];
+      for (unsigned int line = 0; line < m_candidateLines.size(); ++line) {
+        State child{state.m_slicer, state.m_lines, {}, 0., 0.};
+        child.m_slicer.SetStartPoint(m_candidateLines[line].GetA());
+        ++slicesCount;
+        if (!child.m_slicer.SliceIt(m_candidateLines[line].GetB(), changeSet) || changeSet.m_removedIds.empty()) {
+          continue;
+        }
+        ++goodSlicesCount;
+
+        child.m_lines.push_back(line);
+        Evaluate(child);
+        if (IsHopeless(child)) {
+          ++prunedStatesCount;
+          continue;
+        }
+        children.push_back(std::move(child));
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(childrenMutex);
+    std::move(children.begin(), children.end(), std::back_inserter(p_children));
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int k = 1; k < p_threadsCount; ++k) {
+    threads.emplace_back(expandStates);
+  }
+  expandStates();
+  for (auto& thread: threads) {
+    thread.join();
+  }
+
+  m_statistics.m_expandedStatesCount += p_states.size();
+  m_statistics.m_slicesCount += slicesCount;
+  m_statistics.m_goodSlicesCount += goodSlicesCount;
+  m_statistics.m_prunedStatesCount += prunedStatesCount;
+}
+
+LevelSolver::Solution LevelSolver::ToSolution(State const& p_state) const {
+  Solution solution;
+  solution.m_isSolved = IsSolved(p_state);
+  for (auto line: p_state.m_lines) {
+    solution.m_lines.push_back(m_candidateLines[line]);
+  }
+  solution.m_areas = p_state.m_areas;
+  solution.m_gap = p_state.m_gap;
+  return solution;
+}
+
+LevelSolver::Solution LevelSolver::Solve(Options const& p_options) {
+  auto start = std::chrono::steady_clock::now();
+  m_statistics = Statistics();
+  m_statistics.m_threadsCount = p_options.m_threadsCount != 0 ? p_options.m_threadsCount : std::max(1u, std::thread::hardware_concurrency());
+
+  // Areas are shares of the total area, and of the ideal part area
+  if (!HasValidGoals()) {
+    std::cerr << "Error within LevelSolver::Solve: level has no area, or its lines or parts goal is not positive." << std::endl;
+    return Solution();
+  }
+
+  ComputeCandidateLines(p_options.m_boundarySamplesCount);
+  m_statistics.m_candidateLinesCount = static_cast<unsigned int>(m_candidateLines.size());
+
+  State root{Slicer(), {}, {}, 0., 0.};
+  root.m_slicer.SetPolygonsList(m_polygonsList);
+  root.m_slicer.SeObjectsList(m_objectsList);
+  root.m_slicer.InitTotalOrientedArea();
+  Evaluate(root);
+
+  std::vector<State> beam;
+  beam.push_back(std::move(root));
+  State best = beam.front();
+  bool isSolved = IsSolved(best);
+
+  auto byScore = [](State const& p_left, State const& p_right) {
+    return std::tie(p_left.m_score, p_left.m_gap) < std::tie(p_right.m_score, p_right.m_gap);
+  };
+
+  for (int depth = 1; depth <= m_goals.m_linesGoal && !isSolved && !beam.empty(); ++depth) {
+    m_statistics.m_depthReached = static_cast<unsigned int>(depth);
+
+    std::vector<State> children;
+    Expand(beam, children, m_statistics.m_threadsCount);
+
+    // Lowest gap among solutions first, then best score; threads append in any order
+    std::sort(children.begin(), children.end(), [this, &byScore](State const& p_left, State const& p_right) {
+      bool isLeftSolved = IsSolved(p_left);
+      bool isRightSolved = IsSolved(p_right);
+      if (isLeftSolved != isRightSolved) {
+        return isLeftSolved;
+      }
+      if (isLeftSolved) {
+        return std::tie(p_left.m_gap, p_left.m_lines) < std::tie(p_right.m_gap, p_right.m_lines);
+      }
+      return byScore(p_left, p_right) || (!byScore(p_right, p_left) && p_left.m_lines < p_right.m_lines);
+    });
+
+    // Cuts in another order, or along close lines, often give the same parts
+    std::set<std::vector<long long>> keys;
+    beam.clear();
+    for (auto& child: children) {
+      if (beam.size() == p_options.m_beamWidth) {
+        break;
+      }
+      std::vector<long long> key;
+      for (double area: child.m_areas) {
+        key.push_back(std::llround(area/AreaQuantum));
+      }
+      if (!keys.insert(key).second) {
+        ++m_statistics.m_duplicateStatesCount;
+        continue;
+      }
+      beam.push_back(std::move(child));
+    }
+
+    if (!beam.empty()) {
+      best = beam.front();
+      isSolved = IsSolved(best);
+    }
+    PPXL_TRACE(eSlicer, "solver depth " << depth << ": " << children.size() << " children, best gap " << best.m_gap << ", score " << best.m_score);
+  }
+
+  m_statistics.m_milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  return ToSolution(best);
+}
@@ -0,0 +1,86 @@
+#ifndef LEVELSOLVER_HXX
+#define LEVELSOLVER_HXX
+
+#include "Core/Slicer.hxx"
+
+#include <vector>
+
+class Object;
+
+// Searches for the fewest cuts that meet a level's goals: exactly m_partsGoal parts, whose areas
+// (in percent of the level) differ by m_maxGapToWin at most, in m_linesGoal lines or less.
+//
+// Candidate cuts cross the whole level: lines through every pair of vertices, or of points along
+// mirrors and portal entries, and lines between points sampled on the sides of the level's box.
+// The search is a beam search, one line at a time, stopping at the first depth with a solution.
+// States where a part is already too small for the gap goal, or where there are too many parts,
+// are pruned; the others are ranked by how far their areas are from multiples of the ideal part
+// area. States are expanded in parallel.
+class LevelSolver {
+public:
+  struct Goals {
+    int m_linesGoal;
+    int m_partsGoal;
+    int m_maxGapToWin;
+  };
+
+  struct Options {
+    unsigned int m_beamWidth = 48;
+    unsigned int m_boundarySamplesCount = 12;
+    // 0 for as many as the hardware runs
+    unsigned int m_threadsCount = 0;
+  };
+
+  struct Statistics {
+    unsigned int m_candidateLinesCount = 0;
+    unsigned int m_threadsCount = 0;
+    unsigned int m_depthReached = 0;
+    unsigned long m_expandedStatesCount = 0;
+    unsigned long m_slicesCount = 0;
+    unsigned long m_goodSlicesCount = 0;
+    unsigned long m_prunedStatesCount = 0;
+    unsigned long m_duplicateStatesCount = 0;
+    double m_milliseconds = 0.;
+  };
+
+  // When no solution is found, the best ranked state of the deepest level searched
+  struct Solution {
+    bool m_isSolved = false;
+    std::vector<ppxl::Segment> m_lines;
+    std::vector<double> m_areas;
+    double m_gap = 0.;
+  };
+
+  LevelSolver(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Object*> const& p_objectsList, Goals const& p_goals);
+
+  // Positive lines and parts goals, and polygons with an area; Solve gives up at once otherwise
+  bool HasValidGoals() const;
+  Solution Solve(Options const& p_options);
+  inline Statistics const& GetStatistics() const { return m_statistics; }
+  inline std::vector<ppxl::Segment> const& GetCandidateLines() const { return m_candidateLines; }
+
+private:
+  struct State {
+    Slicer m_slicer;
+    std::vector<unsigned int> m_lines;
+    std::vector<double> m_areas;
+    double m_gap;
+    double m_score;
+  };
+
+  void ComputeCandidateLines(unsigned int p_boundarySamplesCount);
+  void Evaluate(State& p_state) const;
+  bool IsSolved(State const& p_state) const;
+  bool IsHopeless(State const& p_state) const;
+  void Expand(std::vector<State> const& p_states, std::vector<State>& p_children, unsigned int p_threadsCount);
+  Solution ToSolution(State const& p_state) const;
+
+  std::vector<ppxl::Polygon> m_polygonsList;
+  std::vector<Object*> m_objectsList;
+  Goals m_goals;
+  double m_totalArea;
+  std::vector<ppxl::Segment> m_candidateLines;
+  Statistics m_statistics;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#include "Trace.hxx"
+
+void Trace::Record(Category p_category, std::string p_message) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_messages[m_next] = Message{p_category, std::move(p_message)};
+  m_next = (m_next+1) % MessagesCount;
+  m_full = m_full || m_next == 0;
+}
+
+void Trace::Dump(std::ostream& p_os) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  unsigned int first = m_full ? m_next : 0;
+  unsigned int count = m_full ? MessagesCount : m_next;
+  for (unsigned int k = 0; k < count; ++k) {
+    Message const& message = m_messages[(first+k) % MessagesCount];
+    p_os << "[" << GetCategoryName(message.m_category) << "] " << message.m_text << std::endl;
+  }
+}
+
+void Trace::Clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& message: m_messages) {
+    message.m_text.clear();
+  }
+  m_next = 0;
+  m_full = false;
+}
+
+char const* Trace::GetCategoryName(Category p_category) {
+  switch (p_category) {
+  case eGeometry:
+    return "geometry";
+  case eSlicer:
+    return "slicer";
+  case eParser:
+    return "parser";
+  case eEditor:
+    return "editor";
+  default:
+    return "unknown";
+  }
+}
@@ -0,0 +1,61 @@
+#ifndef TRACE_HXX
+#define TRACE_HXX
+
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+// Categories compiled in, as a mask of Trace::Category. Nothing is traced by default: disabled
+// categories cost nothing at runtime, their messages are not even formatted.
+#ifndef PPXL_TRACE_CATEGORIES
+#define PPXL_TRACE_CATEGORIES 0
+#endif
+
+// Keeps the last traced messages in a ring buffer, to be dumped on demand.
+class Trace {
+
+public:
+  enum Category {
+    eGeometry = 1 << 0,
+    eSlicer = 1 << 1,
+    eParser = 1 << 2,
+    eEditor = 1 << 3
+  };
+
+  static constexpr unsigned int EnabledCategories = PPXL_TRACE_CATEGORIES;
+  static constexpr unsigned int MessagesCount = 1024;
+
+  static constexpr bool IsEnabled(Category p_category) { return (EnabledCategories & p_category) != 0; }
+
+  static void Record(Category p_category, std::string p_message);
+  // Oldest message first
+  static void Dump(std::ostream& p_os);
+  static void Clear();
+
+  static char const* GetCategoryName(Category p_category);
+
+private:
+  struct Message {
+    Category m_category;
+    std::string m_text;
+  };
+
+  static inline std::mutex m_mutex;
+  static inline std::array<Message, MessagesCount> m_messages;
+  static inline unsigned int m_next = 0;
+  static inline bool m_full = false;
+};
+
+// p_message is anything that can be streamed, e.g. "bounce " << counter << line
+#define PPXL_TRACE(p_category, p_message) \
+  do { \
+    if constexpr (Trace::IsEnabled(Trace::p_category)) { \
+      std::ostringstream traceStream; \
+      traceStream << p_message; \
+      Trace::Record(Trace::p_category, traceStream.str()); \
+    } \
+  } while (false)
+
+#endif
@@ -0,0 +1,188 @@
+#include "LevelValidator.hxx"
+
+#include "Core/Geometry/Segment.hxx"
+#include "Core/Geometry/SpatialIndex.hxx"
+#include "Core/Trace.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+// Touching boxes still make a candidate pair
+constexpr double BoxMargin = 1e-6;
+
+}
+
+LevelValidator::LevelValidator(unsigned int p_threadsCount):
+  m_threadsCount(p_threadsCount),
+  m_statistics() {
+}
+
+char const* LevelValidator::GetIssueName(IssueType p_type) {
+  switch (p_type) {
+  case eNotEnoughVertices:
+    return "not_enough_vertices";
+  case eBadPolygon:
+    return "bad_polygon";
+  case eOverlap:
+    return "overlap";
+  }
+  return "unknown";
+}
+
+bool LevelValidator::HasVertexOrEdgeIn(ppxl::Polygon const& p_polygon, ppxl::Polygon const& p_container) {
+  auto const& vertices = p_polygon.GetVertices();
+  for (unsigned int k = 0; k < vertices.size(); ++k) {
+    auto const& A = vertices[k];
+    auto const& B = vertices[(k+1)%vertices.size()];
+    if (p_container.IsPointInside(A) || p_container.IsCrossing(ppxl::Segment(A, B))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LevelValidator::AreOverlapping(ppxl::Polygon const& p_polygon1, ppxl::Polygon const& p_polygon2) {
+  return HasVertexOrEdgeIn(p_polygon1, p_polygon2) || HasVertexOrEdgeIn(p_polygon2, p_polygon1);
+}
+
+void LevelValidator::RunChecks(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Check>& p_checks, std::vector<Issue>& p_issues) {
+  // Builds the polygons' caches now: the threads below only read them
+  std::vector<bool> isChecked(p_polygonsList.size(), false);
+  for (auto const& check: p_checks) {
+    for (auto polygon: {check.m_polygon, check.m_otherPolygon}) {
+      if (!isChecked[polygon]) {
+        p_polygonsList[polygon].BuildCaches();
+        isChecked[polygon] = true;
+      }
+    }
+  }
+
+  std::stable_sort(p_checks.begin(), p_checks.end(), [](Check const& p_left, Check const& p_right) {
+    return p_left.m_cost > p_right.m_cost;
+  });
+
+  unsigned int threadsCount = m_threadsCount != 0 ? m_threadsCount : std::max(1u, std::thread::hardware_concurrency());
+  threadsCount = std::max(1u, std::min<unsigned int>(threadsCount, static_cast<unsigned int>(p_checks.size())));
+  m_statistics.m_threadsCount = threadsCount;
+
+  std::atomic<unsigned int> nextCheck(0);
+  std::mutex issuesMutex;
+  auto runChecks = [&]() {
+    std::vector<Issue> threadIssues;
+    for (unsigned int index = nextCheck++; index < p_checks.size(); index = nextCheck++) {
+      auto const& check = p_checks[index];
+      auto const& polygon = p_polygonsList[check.m_polygon];
+      if (check.m_polygon == check.m_otherPolygon) {
+        if (!polygon.IsGoodPolygon()) {
+          threadIssues.push_back({eBadPolygon, check.m_polygon, check.m_polygon, polygon.ComputeCrossingEdges()});
+        }
+      } else if (AreOverlapping(polygon, p_polygonsList[check.m_otherPolygon])) {
+        threadIssues.push_back({eOverlap, check.m_polygon, check.m_otherPolygon, {}});
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(issuesMutex);
+    p_issues.insert(p_issues.end(), threadIssues.begin(), threadIssues.end());
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned int k = 1; k < threadsCount; ++k) {
+    threads.emplace_back(runChecks);
+  }
+  runChecks();
+  for (auto& thread: threads) {
+    thread.join();
+  }
+}
+
+std::vector<LevelValidator::Issue> LevelValidator::Validate(std::vector<ppxl::Polygon> const& p_polygonsList) {
+  m_polygonsList.clear();
+  m_issues.clear();
+  return Update(p_polygonsList);
+}
+
+std::vector<LevelValidator::Issue> LevelValidator::Update(std::vector<ppxl::Polygon> const& p_polygonsList) {
+  auto start = std::chrono::steady_clock::now();
+  auto polygonsCount = static_cast<unsigned int>(p_polygonsList.size());
+  m_statistics = Statistics();
+  m_statistics.m_polygonsCount = polygonsCount;
+  m_statistics.m_pairsCount = static_cast<unsigned long>(polygonsCount)*(polygonsCount - (polygonsCount == 0 ? 0 : 1))/2;
+
+  std::vector<bool> isChanged(polygonsCount);
+  for (unsigned int k = 0; k < polygonsCount; ++k) {
+    isChanged[k] = k >= m_polygonsList.size() || !(p_polygonsList[k] == m_polygonsList[k]);
+  }
+
+  // m_otherPolygon is never lower than m_polygon
+  std::vector<Issue> issues;
+  for (auto const& issue: m_issues) {
+    if (issue.m_otherPolygon < polygonsCount && !isChanged[issue.m_polygon] && !isChanged[issue.m_otherPolygon]) {
+      issues.push_back(issue);
+    }
+  }
+
+  // Polygons without enough vertices have no meaningful box, and are left out of the index
+  std::vector<ppxl::BoundingBox> boxes;
+  std::vector<unsigned int> indexedPolygons;
+  for (unsigned int k = 0; k < polygonsCount; ++k) {
+    if (p_polygonsList[k].HasEnoughVertices()) {
+      boxes.push_back(p_polygonsList[k].GetBoundingBox().Inflated(BoxMargin));
+      indexedPolygons.push_back(k);
+    }
+  }
+  ppxl::SpatialIndex index;
+  index.Build(boxes);
+
+  std::vector<Check> checks;
+  std::vector<ppxl::SpatialIndex::ItemIndex> neighbours;
+  for (unsigned int item = 0, k = 0; k < polygonsCount; ++k) {
+    auto const& polygon = p_polygonsList[k];
+    if (!polygon.HasEnoughVertices()) {
+      if (isChanged[k]) {
+        issues.push_back({eNotEnoughVertices, k, k, {}});
+      }
+      continue;
+    }
+    auto const& box = boxes[item++];
+    if (!isChanged[k]) {
+      continue;
+    }
+
+    unsigned long verticesCount = polygon.GetVerticesCount();
+    checks.push_back({k, k, verticesCount*verticesCount});
+    ++m_statistics.m_checkedPolygonsCount;
+
+    neighbours.clear();
+    index.Query(box, neighbours);
+    for (auto neighbour: neighbours) {
+      unsigned int other = indexedPolygons[neighbour];
+      // Pairs of changed polygons are checked once, from the lower one
+      if (other == k || (isChanged[other] && other < k)) {
+        continue;
+      }
+      checks.push_back({std::min(k, other), std::max(k, other), verticesCount*p_polygonsList[other].GetVerticesCount()});
+      ++m_statistics.m_candidatePairsCount;
+    }
+  }
+
+  RunChecks(p_polygonsList, checks, issues);
+
+  std::sort(issues.begin(), issues.end(), [](Issue const& p_left, Issue const& p_right) {
+    return std::tie(p_left.m_polygon, p_left.m_type, p_left.m_otherPolygon) < std::tie(p_right.m_polygon, p_right.m_type, p_right.m_otherPolygon);
+  });
+  m_polygonsList = p_polygonsList;
+  m_issues = issues;
+
+  m_statistics.m_milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  PPXL_TRACE(eGeometry, "LevelValidator::Update: " << issues.size() << " issues, " << m_statistics.m_checkedPolygonsCount
+    << " polygons and " << m_statistics.m_candidatePairsCount << " of " << m_statistics.m_pairsCount << " pairs checked in "
+    << m_statistics.m_milliseconds << " ms");
+
+  return issues;
+}
@@ -0,0 +1,71 @@
+#ifndef LEVELVALIDATOR_HXX
+#define LEVELVALIDATOR_HXX
+
+#include "Core/Geometry/Polygon.hxx"
+
+#include <vector>
+
+// Checks that a level's polygons can be played: each one has enough vertices and no crossed or
+// aligned edges, and no two of them overlap.
+//
+// Only the pairs whose boxes touch, found through a SpatialIndex, are checked. The validator keeps
+// the last polygons and issues it got, so that Update only checks the polygons that changed since,
+// alone and against their neighbours. Checks run on worker threads, which take them one by one,
+// the most expensive first, so that a few large polygons do not leave the other threads idle.
+class LevelValidator {
+public:
+  enum IssueType {
+    eNotEnoughVertices,
+    eBadPolygon,
+    eOverlap
+  };
+
+  // m_otherPolygon is only meaningful for eOverlap, and is greater than m_polygon
+  struct Issue {
+    IssueType m_type;
+    unsigned int m_polygon;
+    unsigned int m_otherPolygon;
+    // For eBadPolygon, the edges to point out to the user, if some cross
+    std::vector<ppxl::Polygon::EdgesPair> m_crossingEdges;
+  };
+
+  struct Statistics {
+    unsigned int m_polygonsCount = 0;
+    unsigned int m_checkedPolygonsCount = 0;
+    unsigned long m_pairsCount = 0;
+    unsigned long m_candidatePairsCount = 0;
+    unsigned int m_threadsCount = 0;
+    double m_milliseconds = 0.;
+  };
+
+  // 0 for as many threads as the hardware runs
+  explicit LevelValidator(unsigned int p_threadsCount = 0);
+
+  // Issues sorted by polygon, then by type and other polygon
+  std::vector<Issue> Validate(std::vector<ppxl::Polygon> const& p_polygonsList);
+  // Same result as Validate, reusing what is known of the polygons that did not change since the
+  // previous call. Polygons are matched by index.
+  std::vector<Issue> Update(std::vector<ppxl::Polygon> const& p_polygonsList);
+  inline Statistics const& GetStatistics() const { return m_statistics; }
+
+  static char const* GetIssueName(IssueType p_type);
+
+private:
+  struct Check {
+    unsigned int m_polygon;
+    // Same as m_polygon for the checks of a polygon alone
+    unsigned int m_otherPolygon;
+    unsigned long m_cost;
+  };
+
+  void RunChecks(std::vector<ppxl::Polygon> const& p_polygonsList, std::vector<Check>& p_checks, std::vector<Issue>& p_issues);
+  static bool AreOverlapping(ppxl::Polygon const& p_polygon1, ppxl::Polygon const& p_polygon2);
+  static bool HasVertexOrEdgeIn(ppxl::Polygon const& p_polygon, ppxl::Polygon const& p_container);
+
+  unsigned int m_threadsCount;
+  std::vector<ppxl::Polygon> m_polygonsList;
+  std::vector<Issue> m_issues;
+  Statistics m_statistics;
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include "WorldMap.hxx"
+
+#include "Core/Trace.hxx"
+
+#include <algorithm>
+#include <charconv>
+#include <sstream>
+
+namespace {
+
+struct ParsedPath {
+  int m_start;
+  int m_end;
+  std::vector<WorldMap::Direction> m_directions;
+};
+
+bool ParseLevel(std::string const& p_text, int& p_level) {
+  auto begin = p_text.data();
+  auto end = p_text.data() + p_text.size();
+  auto result = std::from_chars(begin, end, p_level);
+  return result.ec == std::errc() && result.ptr == end && 1 <= p_level && p_level <= WorldMap::MaxLevelsCount;
+}
+
+bool ParseDirection(std::string const& p_text, WorldMap::Direction& p_direction) {
+  if (p_text == "u") {
+    p_direction = WorldMap::eUp;
+  } else if (p_text == "d") {
+    p_direction = WorldMap::eDown;
+  } else if (p_text == "l") {
+    p_direction = WorldMap::eLeft;
+  } else if (p_text == "r") {
+    p_direction = WorldMap::eRight;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> Split(std::string const& p_text, char p_separator) {
+  std::vector<std::string> fields;
+  std::string field;
+  std::istringstream stream(p_text);
+  while (std::getline(stream, field, p_separator)) {
+    fields.push_back(field);
+  }
+  if (!p_text.empty() && p_text.back() == p_separator) {
+    fields.emplace_back();
+  }
+  return fields;
+}
+
+// "start|directions;end|directions;end"
+bool ParseLine(std::string const& p_line, std::vector<ParsedPath>& p_paths) {
+  auto fields = Split(p_line, '|');
+  int start;
+  if (fields.size() < 2 || !ParseLevel(fields[0], start)) {
+    return false;
+  }
+
+  for (std::size_t k = 1; k < fields.size(); ++k) {
+    auto path = Split(fields[k], ';');
+    ParsedPath parsedPath{start, 0, {}};
+    if (path.size() != 2 || !ParseLevel(path[1], parsedPath.m_end)) {
+      return false;
+    }
+    for (auto const& direction: Split(path[0], ',')) {
+      parsedPath.m_directions.emplace_back();
+      if (!ParseDirection(direction, parsedPath.m_directions.back())) {
+        return false;
+      }
+    }
+    p_paths.push_back(parsedPath);
+  }
+
+  return true;
+}
+
+}
+
+WorldMap::WorldMap():
+  m_levelsCount(0),
+  m_startLevel(0),
+  m_pathsBegin(1, 0),
+  m_pathsEnd(),
+  m_directionsBegin(1, 0),
+  m_directions(),
+  m_nextLevels(),
+  m_previousLevels(),
+  m_reachableLevels() {
+}
+
+bool WorldMap::Parse(std::string const& p_text) {
+  *this = WorldMap();
+
+  std::vector<ParsedPath> parsedPaths;
+  std::istringstream stream(p_text);
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(stream, line)) {
+    ++lineNumber;
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+    if (!ParseLine(line, parsedPaths)) {
+      PPXL_TRACE(eParser, "malformed world map line " << lineNumber << ": " << line);
+      return false;
+    }
+  }
+
+  for (auto const& parsedPath: parsedPaths) {
+    m_levelsCount = std::max({m_levelsCount, parsedPath.m_start, parsedPath.m_end});
+  }
+
+  // Paths grouped by start level, keeping the file order of each level's paths
+  m_pathsBegin.assign(m_levelsCount + 1, 0);
+  for (auto const& parsedPath: parsedPaths) {
+    ++m_pathsBegin[parsedPath.m_start];
+  }
+  for (int level = 0; level < m_levelsCount; ++level) {
+    m_pathsBegin[level + 1] += m_pathsBegin[level];
+  }
+  std::vector<int> order(parsedPaths.size());
+  std::vector<int> next(m_pathsBegin.begin(), m_pathsBegin.end() - 1);
+  for (std::size_t k = 0; k < parsedPaths.size(); ++k) {
+    order[next[parsedPaths[k].m_start - 1]++] = static_cast<int>(k);
+  }
+
+  m_nextLevels.assign(m_levelsCount, 0);
+  m_previousLevels.assign(m_levelsCount, 0);
+  m_pathsEnd.reserve(parsedPaths.size());
+  m_directionsBegin.reserve(parsedPaths.size() + 1);
+  for (int index: order) {
+    auto const& parsedPath = parsedPaths[index];
+    m_pathsEnd.push_back(parsedPath.m_end);
+    m_directions.insert(m_directions.end(), parsedPath.m_directions.begin(), parsedPath.m_directions.end());
+    m_directionsBegin.push_back(static_cast<int>(m_directions.size()));
+    m_nextLevels[parsedPath.m_start - 1] |= GetMask(parsedPath.m_end);
+    m_previousLevels[parsedPath.m_end - 1] |= GetMask(parsedPath.m_start);
+  }
+
+  for (int level = 1; level <= m_levelsCount; ++level) {
+    if (m_previousLevels[level - 1] == 0) {
+      m_startLevel = level;
+      break;
+    }
+  }
+
+  ComputeReachableLevels();
+
+  return true;
+}
+
+// Propagates next levels until nothing changes, which also handles maps with cycles
+void WorldMap::ComputeReachableLevels() {
+  m_reachableLevels = m_nextLevels;
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int level = 1; level <= m_levelsCount; ++level) {
+      LevelsMask reachableLevels = m_reachableLevels[level - 1];
+      for (int nextLevel = 1; nextLevel <= m_levelsCount; ++nextLevel) {
+        if (m_nextLevels[level - 1] & GetMask(nextLevel)) {
+          reachableLevels |= m_reachableLevels[nextLevel - 1];
+        }
+      }
+      if (reachableLevels != m_reachableLevels[level - 1]) {
+        m_reachableLevels[level - 1] = reachableLevels;
+        changed = true;
+      }
+    }
+  }
+}
+
+std::vector<WorldMap::Path> WorldMap::GetPaths(int p_level) const {
+  std::vector<Path> paths;
+  for (int k = m_pathsBegin[p_level - 1]; k < m_pathsBegin[p_level]; ++k) {
+    paths.push_back({m_pathsEnd[k], std::vector<Direction>(m_directions.begin() + m_directionsBegin[k], m_directions.begin() + m_directionsBegin[k + 1])});
+  }
+  return paths;
+}
+
+WorldMap::LevelsMask WorldMap::GetUnlockedLevels(LevelsMask p_completedLevels) const {
+  LevelsMask unlockedLevels = m_startLevel != 0 ? GetMask(m_startLevel) : 0;
+  for (int level = 1; level <= m_levelsCount; ++level) {
+    if (p_completedLevels & GetMask(level)) {
+      unlockedLevels |= m_nextLevels[level - 1];
+    }
+  }
+  return unlockedLevels;
+}
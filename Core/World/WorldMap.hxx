@@ -0,0 +1,73 @@
+#ifndef WORLDMAP_HXX
+#define WORLDMAP_HXX
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Graph of a world's levels, read from a .map file where each line lists the paths leaving a level:
+//   start|direction,...,direction;end|direction,...;end
+// Levels are numbered from 1 in the file. Sets of levels are bitmaps where level n is bit n-1,
+// so that a player's progress fits in a single word and unlocking queries are constant time.
+class WorldMap {
+public:
+  using LevelsMask = std::uint64_t;
+  static constexpr int MaxLevelsCount = 64;
+
+  enum Direction {
+    eUp,
+    eDown,
+    eLeft,
+    eRight
+  };
+
+  struct Path {
+    int m_end;
+    std::vector<Direction> m_directions;
+  };
+
+  WorldMap();
+
+  // Leaves the map empty and returns false when p_text is malformed
+  bool Parse(std::string const& p_text);
+
+  inline int GetLevelsCount() const { return m_levelsCount; }
+  inline bool IsLevel(int p_level) const { return 1 <= p_level && p_level <= m_levelsCount; }
+  // First level with no path leading to it
+  inline int GetStartLevel() const { return m_startLevel; }
+
+  inline static LevelsMask GetMask(int p_level) { return LevelsMask(1) << (p_level - 1); }
+  inline LevelsMask GetAllLevels() const { return m_levelsCount == MaxLevelsCount ? ~LevelsMask(0) : GetMask(m_levelsCount + 1) - 1; }
+
+  // Paths leaving p_level, in file order
+  std::vector<Path> GetPaths(int p_level) const;
+  inline LevelsMask GetNextLevels(int p_level) const { return m_nextLevels[p_level - 1]; }
+  inline LevelsMask GetPreviousLevels(int p_level) const { return m_previousLevels[p_level - 1]; }
+  // Every level some sequence of paths leads to from p_level
+  inline LevelsMask GetReachableLevels(int p_level) const { return m_reachableLevels[p_level - 1]; }
+
+  // The start level is always unlocked, any other one once a level leading to it is completed
+  inline bool IsUnlocked(int p_level, LevelsMask p_completedLevels) const {
+    return p_level == m_startLevel || (p_completedLevels & m_previousLevels[p_level - 1]) != 0;
+  }
+  LevelsMask GetUnlockedLevels(LevelsMask p_completedLevels) const;
+
+private:
+  void ComputeReachableLevels();
+
+  int m_levelsCount;
+  int m_startLevel;
+
+  // Paths leaving level n are indices m_pathsBegin[n-1] to m_pathsBegin[n] of m_pathsEnd, and
+  // the directions of path k are m_directions[m_directionsBegin[k]] to m_directions[m_directionsBegin[k+1]]
+  std::vector<int> m_pathsBegin;
+  std::vector<int> m_pathsEnd;
+  std::vector<int> m_directionsBegin;
+  std::vector<Direction> m_directions;
+
+  std::vector<LevelsMask> m_nextLevels;
+  std::vector<LevelsMask> m_previousLevels;
+  std::vector<LevelsMask> m_reachableLevels;
+};
+
+#endif
@@ -0,0 +1,21 @@
+# Settings shared by ppxl-core.pro and the projects linking ppxl-core.
+# POLYPIXEL.pro builds the library before them, in the shadow of this directory.
+
+INCLUDEPATH += $$PWD/..
+
+# Trace categories compiled in, see Trace.hxx: 1 geometry, 2 slicer, 4 parser, 8 editor
+# DEFINES += PPXL_TRACE_CATEGORIES=0xF
+# Tracing costs nothing when compiled out: to measure what it costs when compiled in, run
+# SlicerBenchmark from a build with qmake "DEFINES += PPXL_TRACE_CATEGORIES=0xF" and from one
+# without, and compare their percentiles. --trace also dumps the messages.
+
+!equals(TARGET, ppxl-core) {
+  PPXL_CORE_DIR = $$shadowed($$PWD)
+  LIBS += -L$$PPXL_CORE_DIR -lppxl-core
+
+  win32-msvc* {
+    PRE_TARGETDEPS += $$PPXL_CORE_DIR/ppxl-core.lib
+  } else {
+    PRE_TARGETDEPS += $$PPXL_CORE_DIR/libppxl-core.a
+  }
+}
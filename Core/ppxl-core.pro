@@ -0,0 +1,91 @@
+#-------------------------------------------------
+#
+# Geometry and slicing engine, without any Qt dependency
+# so that the game and the headless tools share it.
+#
+#-------------------------------------------------
+
+CONFIG -= qt
+
+TARGET = ppxl-core
+TEMPLATE = lib
+
+CONFIG += staticlib c++17
+
+# Keeps the library next to its Makefile for ppxl-core.pri, even in debug_and_release builds
+DESTDIR = $$OUT_PWD
+
+# Predicates::Orient2d bounds the rounding error of two separately rounded products: an FMA would
+# break the bound, and the predicate is inlined in Segment, Vector and Polygon.
+*-g++*|*-clang*|*-icc* {
+  QMAKE_CXXFLAGS += -ffp-contract=off
+}
+
+include(ppxl-core.pri)
+
+SOURCES += \
+# GEOMETRY
+    Geometry/Point.cxx \
+    Geometry/Polygon.cxx \
+    Geometry/Predicates.cxx \
+    Geometry/Segment.cxx \
+    Geometry/SpatialIndex.cxx \
+    Geometry/Vector.cxx \
+# OBJECTS
+    Objects/Deviations/Deviation.cxx \
+    Objects/Deviations/DeviationTracer.cxx \
+    Objects/Deviations/Mirror.cxx \
+    Objects/Deviations/Portal.cxx \
+    Objects/Mutables/Countdown.cxx \
+    Objects/Mutables/Mutable.cxx \
+    Objects/Mutables/Disposable.cxx \
+    Objects/Mutables/Switch.cxx \
+    Objects/Mutables/Transfer.cxx \
+    Objects/Obstacles/Tape.cxx \
+    Objects/Obstacles/Obstacle.cxx \
+    Objects/Obstacles/OneWay.cxx \
+    Objects/Object.cxx \
+# SLICER
+    LatencyHistogram.cxx \
+    Slicer.cxx \
+    Trace.cxx \
+# SOLVER
+    Solver/LevelSolver.cxx \
+# VALIDATOR
+    Validator/LevelValidator.cxx \
+# WORLD
+    World/WorldMap.cxx
+
+HEADERS += \
+# GEOMETRY
+    Geometry/BoundingBox.hxx \
+    Geometry/Point.hxx \
+    Geometry/Polygon.hxx \
+    Geometry/Predicates.hxx \
+    Geometry/Segment.hxx \
+    Geometry/SpatialIndex.hxx \
+    Geometry/Vector.hxx \
+# OBJECTS
+    Objects/Deviations/Deviation.hxx \
+    Objects/Deviations/DeviationTracer.hxx \
+    Objects/Deviations/Mirror.hxx \
+    Objects/Deviations/Portal.hxx \
+    Objects/Mutables/Countdown.hxx \
+    Objects/Mutables/Mutable.hxx \
+    Objects/Mutables/Disposable.hxx \
+    Objects/Mutables/Switch.hxx \
+    Objects/Mutables/Transfer.hxx \
+    Objects/Obstacles/Tape.hxx \
+    Objects/Obstacles/Obstacle.hxx \
+    Objects/Obstacles/OneWay.hxx \
+    Objects/Object.hxx \
+# SLICER
+    LatencyHistogram.hxx \
+    Slicer.hxx \
+    Trace.hxx \
+# SOLVER
+    Solver/LevelSolver.hxx \
+# VALIDATOR
+    Validator/LevelValidator.hxx \
+# WORLD
+    World/WorldMap.hxx
@@ -2,7 +2,63 @@
 
 #include "GUI/ChooseLevel/Views/ChooseLevelWidget.hxx"
 
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QStandardPaths>
+
 ChooseLevelController::ChooseLevelController(ChooseLevelWidget* p_chooseLevelWidget, QObject *p_parent):
-  QObject(p_parent) {
+  QObject(p_parent),
+  m_chooseLevelWidget(p_chooseLevelWidget),
+  m_worldPack(),
+  m_worldMap(),
+  // Progress is not saved yet: every level counts as completed, so that all of them can be played
+  m_completedLevels(~WorldMap::LevelsMask(0)) {
+
+  OpenWorldPack();
+  m_worldMap.Parse(m_worldPack.GetMap().toStdString());
+  SetLevelItems();
+}
+
+void ChooseLevelController::SetCompletedLevels(WorldMap::LevelsMask p_completedLevels) {
+  m_completedLevels = p_completedLevels;
+  SetLevelItems();
+}
+
+// Levels and map are compiled in the application: the pack is built from them on first launch,
+// and again whenever the application is newer than the pack
+void ChooseLevelController::OpenWorldPack() {
+  QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+  cacheDir.mkpath(".");
+  QString packFileName = cacheDir.filePath(QString("world1.%1").arg(WorldPack::Suffix));
+
+  QFileInfo packInfo(packFileName);
+  bool isUpToDate = packInfo.exists() && packInfo.lastModified() >= QFileInfo(QCoreApplication::applicationFilePath()).lastModified();
+  if (isUpToDate && m_worldPack.Open(packFileName)) {
+    return;
+  }
+
+  QStringList levelsFileNames;
+  QDir levelsDir(":/levels");
+  for (auto const& fileName: levelsDir.entryList({"*.ppxl"}, QDir::Files, QDir::Name)) {
+    levelsFileNames << levelsDir.filePath(fileName);
+  }
+  if (WorldPack::Write(levelsFileNames, ":/maps/world1.map", packFileName)) {
+    m_worldPack.Open(packFileName);
+  }
+}
 
+void ChooseLevelController::SetLevelItems() {
+  m_chooseLevelWidget->ClearLevels();
+  for (int k = 0; k < m_worldPack.GetLevelsCount(); ++k) {
+    auto levelInfo = m_worldPack.GetLevelInfo(k);
+    // Wraps the mapped bytes, the widget makes its own copy
+    QImage thumbnail(m_worldPack.GetThumbnail(k), WorldPack::ThumbnailSize, WorldPack::ThumbnailSize, WorldPack::ThumbnailSize, QImage::Format_Grayscale8);
+    QString details = QString("%1 lines, %2 parts, %3 objects").arg(levelInfo.m_linesGoal).arg(levelInfo.m_partsGoal).arg(levelInfo.m_objectsCount);
+    // Levels are listed in map order, level k+1 being the k-th of the pack
+    bool isUnlocked = !m_worldMap.IsLevel(k + 1) || m_worldMap.IsUnlocked(k + 1, m_completedLevels);
+    m_chooseLevelWidget->AddLevel(levelInfo.m_fileName, QFileInfo(levelInfo.m_fileName).baseName(), thumbnail, details, isUnlocked);
+  }
 }
@@ -1,6 +1,9 @@
 #ifndef CHOOSELEVELSCONTROLLER_HXX
 #define CHOOSELEVELSCONTROLLER_HXX
 
+#include "Core/World/WorldMap.hxx"
+#include "Parser/WorldPack.hxx"
+
 #include <QObject>
 
 class ChooseLevelWidget;
@@ -11,8 +14,22 @@ class ChooseLevelController: public QObject {
 public:
   explicit ChooseLevelController(ChooseLevelWidget* p_chooseLevelWidget, QObject* p_parent = nullptr);
 
+  inline WorldPack const& GetWorldPack() const { return m_worldPack; }
+  inline WorldMap const& GetWorldMap() const { return m_worldMap; }
+
+  void SetCompletedLevels(WorldMap::LevelsMask p_completedLevels);
+
 Q_SIGNALS:
 
+protected:
+  void OpenWorldPack();
+  void SetLevelItems();
+
+private:
+  ChooseLevelWidget* m_chooseLevelWidget;
+  WorldPack m_worldPack;
+  WorldMap m_worldMap;
+  WorldMap::LevelsMask m_completedLevels;
 };
 
 #endif
@@ -1,10 +1,42 @@
 #include "ChooseLevelWidget.hxx"
 
+#include <QImage>
+#include <QListWidget>
+#include <QPixmap>
+#include <QVBoxLayout>
+
 ChooseLevelWidget::ChooseLevelWidget(QWidget* p_parent):
-  QWidget(p_parent) {
+  QWidget(p_parent),
+  m_levelsListWidget(new QListWidget) {
+
+  m_levelsListWidget->setViewMode(QListView::IconMode);
+  m_levelsListWidget->setIconSize(QSize(128, 128));
+  m_levelsListWidget->setResizeMode(QListView::Adjust);
+  m_levelsListWidget->setMovement(QListView::Static);
+  m_levelsListWidget->setUniformItemSizes(true);
+
+  auto mainLayout = new QVBoxLayout;
+  mainLayout->addWidget(m_levelsListWidget);
+  setLayout(mainLayout);
 
+  connect(m_levelsListWidget, &QListWidget::itemActivated, this, [this](QListWidgetItem* p_item) {
+    Q_EMIT PlayLevelRequested(p_item->data(Qt::UserRole).toString());
+  });
 }
 
 void ChooseLevelWidget::InitView() {
+  m_levelsListWidget->clearSelection();
+}
+
+void ChooseLevelWidget::ClearLevels() {
+  m_levelsListWidget->clear();
+}
 
+void ChooseLevelWidget::AddLevel(QString const& p_levelFileName, QString const& p_title, QImage const& p_thumbnail, QString const& p_details, bool p_isUnlocked) {
+  auto item = new QListWidgetItem(QIcon(QPixmap::fromImage(p_thumbnail)), p_title, m_levelsListWidget);
+  item->setData(Qt::UserRole, p_levelFileName);
+  item->setToolTip(p_details);
+  if (!p_isUnlocked) {
+    item->setFlags(item->flags() & ~Qt::ItemIsEnabled);
+  }
 }
@@ -3,6 +3,9 @@
 
 #include <QWidget>
 
+class QListWidget;
+class QImage;
+
 class ChooseLevelWidget: public QWidget {
   Q_OBJECT
 
@@ -11,9 +14,14 @@ public:
 
   void InitView();
 
+  void ClearLevels();
+  void AddLevel(QString const& p_levelFileName, QString const& p_title, QImage const& p_thumbnail, QString const& p_details, bool p_isUnlocked);
+
 Q_SIGNALS:
   void PlayLevelRequested(QString const& p_levelFileName);
 
+private:
+  QListWidget* m_levelsListWidget;
 };
 
 #endif
@@ -1,13 +1,20 @@
 #include "CreateLevelController.hxx"
 
 #include "GUI/CreateLevel/Views/CreateLevelWidget.hxx"
-#include "Parser/Parser.hxx"
+#include "GUI/CreateLevel/Controllers/LevelValidationService.hxx"
+#include "Parser/LevelIOService.hxx"
+#include "Core/Trace.hxx"
 
 #include <QAction>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QItemSelectionModel>
+#include <QStandardPaths>
+#include <QTimer>
 #include <QToolBar>
 #include <QMouseEvent>
 
+#include <algorithm>
 #include <cmath>
 
 CreateLevelController::CreateLevelController(CreateLevelWidget* p_view, QObject* p_parent):
@@ -27,7 +34,19 @@ CreateLevelController::CreateLevelController(CreateLevelWidget* p_view, QObject*
   m_isNearControlPoint(false),
   m_nearestControlPoint(),
   m_hoveredItem(nullptr),
-  m_clipboardIndex() {
+  m_clipboardIndex(),
+  m_levelIOService(new LevelIOService(this)),
+  m_autosaveTimer(new QTimer(this)),
+  m_autosaveFileName(),
+  m_loadingFileName(),
+  m_levelModified(false),
+  m_autosavePending(false),
+  m_ioLatencies(),
+  m_starsCount(0),
+  m_snapshot(),
+  m_levelValidationService(new LevelValidationService(this)),
+  m_validationTimer(new QTimer(this)),
+  m_validationRevision(0) {
 
   m_createLevelWidget->SetObjectsListModel(m_objectsListModel);
   m_createLevelWidget->SetObjectsDetailModel(m_objectsDetailModel);
@@ -41,6 +60,10 @@ CreateLevelController::CreateLevelController(CreateLevelWidget* p_view, QObject*
   connect(m_vertexListModel, &CreateLevelObjectsListModel::dataChanged, this, &CreateLevelController::CheckTestAvailable);
   connect(m_vertexListModel, &CreateLevelObjectsListModel::rowsInserted, this, &CreateLevelController::CheckTestAvailable);
   connect(m_vertexListModel, &CreateLevelObjectsListModel::rowsRemoved, this, &CreateLevelController::CheckTestAvailable);
+  connect(m_levelValidationService, &LevelValidationService::LevelValidated, this, &CreateLevelController::UpdateTestAvailable);
+  m_validationTimer->setSingleShot(true);
+  m_validationTimer->setInterval(ValidationDelay);
+  connect(m_validationTimer, &QTimer::timeout, this, &CreateLevelController::ValidateLevel);
 
   connect(m_createLevelWidget, &CreateLevelWidget::MousePressed, this, &CreateLevelController::MousePressEvent);
   connect(m_createLevelWidget, &CreateLevelWidget::MouseMoved, this, &CreateLevelController::MouseMoveEvent);
@@ -59,9 +82,31 @@ CreateLevelController::CreateLevelController(CreateLevelWidget* p_view, QObject*
   connect(m_createLevelWidget, &CreateLevelWidget::SelectionChanged, this, &CreateLevelController::UpdateSelection);
   connect(m_createLevelWidget, &CreateLevelWidget::CopyRequested, this, &CreateLevelController::CopyItem);
   connect(m_createLevelWidget, &CreateLevelWidget::PasteRequested, this, &CreateLevelController::PasteItem);
+
+  // Level I/O
+  auto markLevelModified = [this]() {
+    m_levelModified = true;
+  };
+  connect(m_objectsListModel, &CreateLevelObjectsListModel::dataChanged, this, markLevelModified);
+  connect(m_objectsListModel, &CreateLevelObjectsListModel::rowsInserted, this, markLevelModified);
+  connect(m_objectsListModel, &CreateLevelObjectsListModel::rowsRemoved, this, markLevelModified);
+  connect(m_vertexListModel, &CreateLevelObjectsListModel::dataChanged, this, markLevelModified);
+  connect(m_vertexListModel, &CreateLevelObjectsListModel::rowsInserted, this, markLevelModified);
+  connect(m_vertexListModel, &CreateLevelObjectsListModel::rowsRemoved, this, markLevelModified);
+  connect(m_createLevelWidget, &CreateLevelWidget::SaveLevelRequested, this, &CreateLevelController::SaveLevel);
+  connect(m_levelIOService, &LevelIOService::LevelLoaded, this, &CreateLevelController::SetLevel);
+  connect(m_levelIOService, &LevelIOService::LevelSaved, this, &CreateLevelController::UpdateSaveState);
+
+  QDir autosaveDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+  autosaveDir.mkpath(".");
+  m_autosaveFileName = autosaveDir.filePath("autosave.ppxl");
+  connect(m_autosaveTimer, &QTimer::timeout, this, &CreateLevelController::Autosave);
+  m_autosaveTimer->start(AutosaveInterval);
 }
 
-CreateLevelController::~CreateLevelController() = default;
+CreateLevelController::~CreateLevelController() {
+  PPXL_TRACE(eEditor, "level I/O on the GUI thread:\n" << m_ioLatencies << "level I/O on the worker thread:\n" << m_levelIOService->GetWorkerLatencies());
+}
 
 void CreateLevelController::SetToolBar(QToolBar* p_toolbar) {
   m_toolbar = p_toolbar;
@@ -271,44 +316,53 @@ void CreateLevelController::SnapPolygonToGrid(QModelIndex const& p_currentIndex)
   }
 }
 
+// Model signals come by dozens while dragging a vertex: they share a single validation per frame.
+// The level cannot be tested until the worker validated its latest revision.
 void CreateLevelController::CheckTestAvailable() {
-  auto const& polygonsList = m_objectsListModel->GetPolygonsList();
-
-  for (auto polygon: polygonsList) {
-    // Check if a polygon has less than 3 vertices and is not crossed
-    if (!polygon->HasEnoughVertices() || !polygon->IsGoodPolygon()) {
-      m_createLevelWidget->SetTestAvailable(false);
-      if (!polygon->HasEnoughVertices())
-        /// qDebug() << "Not enough vertices";
-      if (!polygon->IsGoodPolygon())
-        /// qDebug() << "Vertex alignment issue";
-      return;
+  m_createLevelWidget->SetTestAvailable(false);
+  if (!m_validationTimer->isActive()) {
+    m_validationTimer->start();
+  }
+}
+
+void CreateLevelController::ValidateLevel() {
+  std::vector<ppxl::Polygon> polygonsList;
+  for (auto const* polygon: m_objectsListModel->GetPolygonsList()) {
+    polygonsList.push_back(*polygon);
+  }
+  m_validationRevision = m_levelValidationService->Validate(polygonsList);
+}
+
+void CreateLevelController::UpdateTestAvailable(unsigned int p_revision, std::vector<LevelValidator::Issue> const& p_issues) {
+  // The level changed again since
+  if (p_revision != m_validationRevision) {
+    return;
+  }
+
+  // Polygons edited since are checked again soon, until then their indices only need to be valid
+  auto polygonsList = m_objectsListModel->GetPolygonsList();
+  QList<QLineF> crossingLines;
+  for (auto const& issue: p_issues) {
+    PPXL_TRACE(eEditor, "polygon " << issue.m_polygon << ": " << LevelValidator::GetIssueName(issue.m_type)
+      << (issue.m_type == LevelValidator::eOverlap ? " with polygon " + std::to_string(issue.m_otherPolygon) : std::string()));
+    if (issue.m_crossingEdges.empty() || issue.m_polygon >= polygonsList.size()) {
+      continue;
     }
-    // Check intersections between polygons
-    for (auto polygon2: polygonsList) {
-      if (polygon == polygon2) {
-        continue;
-      }
-      auto vertices2 = polygon2->GetVertices();
-      for (auto k = 0ul; k < vertices2.size(); ++k) {
-        auto A = vertices2.at(k);
-        if (polygon->IsPointInside(A)) {
-          m_createLevelWidget->SetTestAvailable(false);
-          /// qDebug() << "Polygons overlap issue";
-          return;
-        }
 
-        auto B = vertices2.at((k+1)%vertices2.size());
-        if (polygon->IsCrossing(ppxl::Segment(A, B))) {
-          m_createLevelWidget->SetTestAvailable(false);
-          /// qDebug() << "Polygons overlap issue";
-          return;
-        }
+    auto const& vertices = polygonsList.at(issue.m_polygon)->GetVertices();
+    auto edgeLine = [&vertices](unsigned int p_edge) {
+      auto const& A = vertices.at(p_edge);
+      auto const& B = vertices.at((p_edge+1)%vertices.size());
+      return QLineF(A.GetX(), A.GetY(), B.GetX(), B.GetY());
+    };
+    for (auto const& edges: issue.m_crossingEdges) {
+      if (edges.second < vertices.size()) {
+        crossingLines << edgeLine(edges.first) << edgeLine(edges.second);
       }
     }
   }
-
-  m_createLevelWidget->SetTestAvailable(true);
+  m_createLevelWidget->SetHighlightedLines(crossingLines);
+  m_createLevelWidget->SetTestAvailable(p_issues.empty());
 }
 
 void CreateLevelController::MousePressEvent(QMouseEvent* p_event) {
@@ -650,40 +704,173 @@ void CreateLevelController::NewLevel() {
   m_objectsDetailModel->ClearObject();
   m_vertexListModel->ClearPolygon();
   m_createLevelWidget->ResetGameInfo();
+
+  // Clearing is not an edit: the last autosave keeps the previous level
+  m_loadingFileName.clear();
+  m_levelModified = false;
+  m_starsCount = 0;
+  m_snapshot = Level();
 }
 
 void CreateLevelController::OpenLevel(const QString& p_fileName) {
+  QElapsedTimer timer;
+  timer.start();
+  m_loadingFileName = p_fileName;
+  m_levelIOService->Load(p_fileName);
+  m_ioLatencies.Record(timer.nsecsElapsed()/1000.);
+}
+
+void CreateLevelController::SetLevel(QString const& p_fileName, Level const& p_level) {
+  // Loaded too late: another level was opened or created meanwhile
+  if (p_fileName != m_loadingFileName) {
+    return;
+  }
+
   NewLevel();
-  Parser parser(p_fileName);
-  m_createLevelWidget->SetLinesGoal(parser.GetLinesGoal());
-  m_createLevelWidget->SetPartsGoal(parser.GetPartsGoal());
-  m_createLevelWidget->SetMaxGapToWin(parser.GetMaxGapToWin());
-  m_createLevelWidget->SetTolerance(parser.GetTolerance());
-  for (auto const& polygon: parser.GetPolygonsList()){
+  m_createLevelWidget->SetLinesGoal(p_level.m_linesGoal);
+  m_createLevelWidget->SetPartsGoal(p_level.m_partsGoal);
+  m_createLevelWidget->SetMaxGapToWin(p_level.m_maxGapToWin);
+  m_createLevelWidget->SetTolerance(p_level.m_tolerance);
+  m_starsCount = p_level.m_starsCount;
+  for (auto const& polygon: p_level.m_polygonsList){
     CreatePolygon(polygon);
   }
   m_toolMode = eTapeMode;
-  for (auto const& tape: parser.GetTapesList()) {
+  for (auto const& tape: p_level.m_tapesList) {
     CreateObject(new Tape(tape));
   }
   m_toolMode = eMirrorMode;
-  for (auto const& tape: parser.GetMirrorsList()) {
+  for (auto const& tape: p_level.m_mirrorsList) {
     CreateObject(new Mirror(tape));
   }
   m_toolMode = eOneWayMode;
-  for (auto const& tape: parser.GetOneWaysList()) {
+  for (auto const& tape: p_level.m_oneWaysList) {
     CreateObject(new OneWay(tape));
   }
   m_toolMode = ePortalMode;
-  for (auto const& tape: parser.GetPortalsList()) {
+  for (auto const& tape: p_level.m_portalsList) {
     CreateObject(new Portal(tape));
   }
   m_selectAction->trigger();
+  m_levelModified = false;
+}
+
+void CreateLevelController::SaveLevel(QString const& p_fileName) {
+  QElapsedTimer timer;
+  timer.start();
+  m_levelIOService->Save(TakeSnapshot(), p_fileName);
+  m_ioLatencies.Record(timer.nsecsElapsed()/1000.);
+}
+
+// Skipped while the previous autosave is still being written
+void CreateLevelController::Autosave() {
+  if (!m_levelModified || m_autosavePending) {
+    return;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  m_levelModified = false;
+  m_autosavePending = true;
+  m_levelIOService->Save(TakeSnapshot(), m_autosaveFileName);
+  m_ioLatencies.Record(timer.nsecsElapsed()/1000.);
+}
+
+// A failed autosave is retried with the next one, a failed save is reported
+void CreateLevelController::UpdateSaveState(QString const& p_fileName, bool p_saved) {
+  if (p_fileName == m_autosaveFileName) {
+    m_autosavePending = false;
+    m_levelModified = m_levelModified || !p_saved;
+  } else if (!p_saved) {
+    m_createLevelWidget->ShowSaveError(p_fileName);
+  }
+}
+
+namespace {
+
+bool HaveSameVertices(ppxl::Polygon const& p_polygon1, ppxl::Polygon const& p_polygon2) {
+  auto const& vertices1 = p_polygon1.GetVertices();
+  auto const& vertices2 = p_polygon2.GetVertices();
+  return vertices1.size() == vertices2.size() && std::equal(vertices1.begin(), vertices1.end(), vertices2.begin(),
+    [](ppxl::Point const& p_vertex1, ppxl::Point const& p_vertex2) {
+      return p_vertex1.GetX() == p_vertex2.GetX() && p_vertex1.GetY() == p_vertex2.GetY();
+    });
+}
+
+// Assigns in place, so that items keep their storage. The list detaches, copying every item, only
+// while a queued save still shares it.
+template<typename T>
+void UpdateSnapshotList(QList<T>& p_list, std::vector<T const*> const& p_items) {
+  while (p_list.size() > static_cast<int>(p_items.size())) {
+    p_list.removeLast();
+  }
+  for (unsigned int k = 0; k < p_items.size(); ++k) {
+    if (static_cast<int>(k) == p_list.size()) {
+      p_list.append(*p_items[k]);
+    } else {
+      p_list[static_cast<int>(k)] = *p_items[k];
+    }
+  }
+}
+
+}
+
+// Copies values only, the worker thread does the formatting and the writing. The snapshot is kept
+// between saves: polygons whose vertices did not change since the previous one are not copied again.
+Level const& CreateLevelController::TakeSnapshot() {
+  m_snapshot.m_linesGoal = GetLinesGoal();
+  m_snapshot.m_partsGoal = GetPartsGoal();
+  m_snapshot.m_maxGapToWin = GetMaxGapToWin();
+  m_snapshot.m_tolerance = GetTolerance();
+  m_snapshot.m_starsCount = m_starsCount;
+
+  auto polygonsList = GetPolygonsList();
+  auto& snapshotPolygons = m_snapshot.m_polygonsList;
+  while (snapshotPolygons.size() > static_cast<int>(polygonsList.size())) {
+    snapshotPolygons.removeLast();
+  }
+  for (unsigned int k = 0; k < polygonsList.size(); ++k) {
+    if (static_cast<int>(k) == snapshotPolygons.size()) {
+      snapshotPolygons.append(*polygonsList[k]);
+    } else if (!HaveSameVertices(snapshotPolygons.at(static_cast<int>(k)), *polygonsList[k])) {
+      snapshotPolygons[static_cast<int>(k)].SetVertices(polygonsList[k]->GetVertices());
+    }
+  }
+
+  // Objects are a few coordinates each: they are assigned again, which allocates nothing
+  std::vector<Tape const*> tapesList;
+  std::vector<OneWay const*> oneWaysList;
+  std::vector<Mirror const*> mirrorsList;
+  std::vector<Portal const*> portalsList;
+  for (auto const* object: GetObjectsList()) {
+    switch (object->GetObjectType()) {
+    case Object::eTape:
+      tapesList.push_back(static_cast<Tape const*>(object));
+      break;
+    case Object::eOneWay:
+      oneWaysList.push_back(static_cast<OneWay const*>(object));
+      break;
+    case Object::eMirror:
+      mirrorsList.push_back(static_cast<Mirror const*>(object));
+      break;
+    case Object::ePortal:
+      portalsList.push_back(static_cast<Portal const*>(object));
+      break;
+    default:
+      break;
+    }
+  }
+  UpdateSnapshotList(m_snapshot.m_tapesList, tapesList);
+  UpdateSnapshotList(m_snapshot.m_oneWaysList, oneWaysList);
+  UpdateSnapshotList(m_snapshot.m_mirrorsList, mirrorsList);
+  UpdateSnapshotList(m_snapshot.m_portalsList, portalsList);
+
+  return m_snapshot;
 }
 
 /// REWORK
 void CreateLevelController::UpdateGraphicsSelection(QModelIndex const& p_current, QModelIndex const&) {
-  qDebug() << "UPDATE GRAPHICS SELECTION";
+  PPXL_TRACE(eEditor, "CreateLevelController::UpdateGraphicsSelection");
   DisableObjectItems();
   auto objectListType = CreateLevelObjectsListModel::eUnknownObjectListType;
   QModelIndex listIndex;
@@ -710,7 +897,7 @@ void CreateLevelController::UpdateGraphicsSelection(QModelIndex const& p_current
 
 void CreateLevelController::UpdateSelection() {
   /// NOT CALLED?
-  qDebug() << "UPDATE SELECTION";
+  PPXL_TRACE(eEditor, "CreateLevelController::UpdateSelection");
   for (auto item: m_createLevelWidget->GetGraphicsItemsList()) {
     if (item->flags().testFlag(QGraphicsItem::ItemIsSelectable)) {
       auto objectItem = static_cast<GraphicsObjectItem*>(item);
@@ -5,12 +5,18 @@
 
 #include "Core/Geometry/Polygon.hxx"
 #include "Core/Geometry/Point.hxx"
+#include "Core/LatencyHistogram.hxx"
+#include "Core/Validator/LevelValidator.hxx"
+#include "Parser/Level.hxx"
 #include "GUI/CreateLevel/Views/CreateLevelWidget.hxx"
 #include "GUI/CreateLevel/Models/CreateLevelObjectsListModel.hxx"
 #include "GUI/CreateLevel/Models/CreateLevelObjectsDetailModel.hxx"
 #include "GUI/CreateLevel/Models/CreateLevelVertexListModel.hxx"
 
+class LevelIOService;
+class LevelValidationService;
 class QUndoStack;
+class QTimer;
 class QStandardItem;
 class QToolBar;
 class QMouseEvent;
@@ -29,6 +35,11 @@ public:
     eRectangleSelectionMode
   };
 
+  // Milliseconds between two autosaves of a modified level
+  static constexpr int AutosaveInterval = 30000;
+  // Milliseconds the level's validation waits for other changes, about a frame
+  static constexpr int ValidationDelay = 16;
+
   explicit CreateLevelController(CreateLevelWidget* p_view,  QObject *parent = nullptr);
   ~CreateLevelController() override;
 
@@ -41,6 +52,8 @@ public:
   int GetTolerance() const;
   std::vector<ppxl::Polygon*> GetPolygonsList() const;
   std::vector<Object*> GetObjectsList() const;
+  // Time the GUI thread spends on each load, save or autosave request
+  inline LatencyHistogram const& GetIOLatencies() const { return m_ioLatencies; }
 
   void UpdateView();
 
@@ -57,6 +70,8 @@ protected:
   void SnapObjectToGrid(QModelIndex const& p_currentIndex);
   void SnapPolygonToGrid(QModelIndex const& p_currentIndex);
   void CheckTestAvailable();
+  void ValidateLevel();
+  void UpdateTestAvailable(unsigned int p_revision, std::vector<LevelValidator::Issue> const& p_issues);
 
   void MousePressEvent(QMouseEvent* p_event);
   void MouseMoveEvent(QMouseEvent* p_event);
@@ -75,6 +90,11 @@ protected:
 
   void NewLevel();
   void OpenLevel(QString const& p_fileName);
+  void SetLevel(QString const& p_fileName, Level const& p_level);
+  void SaveLevel(QString const& p_fileName);
+  void Autosave();
+  void UpdateSaveState(QString const& p_fileName, bool p_saved);
+  Level const& TakeSnapshot();
 
   void UpdateGraphicsSelection(QModelIndex const& p_current, QModelIndex const&);
   void UpdateSelection();
@@ -134,6 +154,22 @@ private:
   QStandardItem* m_hoveredItem;
 
   QModelIndex m_clipboardIndex;
+
+  LevelIOService* m_levelIOService;
+  QTimer* m_autosaveTimer;
+  QString m_autosaveFileName;
+  QString m_loadingFileName;
+  bool m_levelModified;
+  bool m_autosavePending;
+  LatencyHistogram m_ioLatencies;
+  // Not edited here: kept from the level loaded, so that saving it does not drop it
+  int m_starsCount;
+  // Implicitly shared with the saves still queued on the worker thread
+  Level m_snapshot;
+
+  LevelValidationService* m_levelValidationService;
+  QTimer* m_validationTimer;
+  unsigned int m_validationRevision;
 };
 
 #endif
@@ -0,0 +1,36 @@
+#include "LevelValidationService.hxx"
+
+LevelValidationService::LevelValidationService(QObject* p_parent):
+  QObject(p_parent),
+  m_thread(),
+  m_worker(new QObject),
+  m_validator(),
+  m_revision(0) {
+
+  m_thread.setObjectName("LevelValidationService");
+  m_worker->moveToThread(&m_thread);
+  m_thread.start();
+}
+
+LevelValidationService::~LevelValidationService() {
+  // Pending requests are outdated anyway
+  m_thread.quit();
+  m_thread.wait();
+  delete m_worker;
+}
+
+unsigned int LevelValidationService::Validate(std::vector<ppxl::Polygon> const& p_polygonsList) {
+  unsigned int revision = ++m_revision;
+  QMetaObject::invokeMethod(m_worker, [this, revision, p_polygonsList]() {
+    if (revision != m_revision) {
+      return;
+    }
+    std::vector<LevelValidator::Issue> issues = m_validator.Update(p_polygonsList);
+
+    QMetaObject::invokeMethod(this, [this, revision, issues]() {
+      Q_EMIT LevelValidated(revision, issues);
+    }, Qt::QueuedConnection);
+  }, Qt::QueuedConnection);
+
+  return revision;
+}
@@ -0,0 +1,36 @@
+#ifndef LEVELVALIDATIONSERVICE_HXX
+#define LEVELVALIDATIONSERVICE_HXX
+
+#include <QObject>
+#include <QThread>
+
+#include <atomic>
+
+#include "Core/Validator/LevelValidator.hxx"
+
+// Validates the edited level's polygons on a worker thread, so that the editor never waits for it.
+// Only the latest request matters: requests that a newer one has replaced by the time the worker
+// gets to them are skipped. The worker's LevelValidator only re-checks what changed since the
+// previous request it validated.
+class LevelValidationService: public QObject {
+  Q_OBJECT
+
+public:
+  explicit LevelValidationService(QObject* p_parent = nullptr);
+  ~LevelValidationService() override;
+
+  // Returns the revision LevelValidated reports for this request
+  unsigned int Validate(std::vector<ppxl::Polygon> const& p_polygonsList);
+
+Q_SIGNALS:
+  void LevelValidated(unsigned int p_revision, std::vector<LevelValidator::Issue> const& p_issues);
+
+private:
+  QThread m_thread;
+  QObject* m_worker;
+  // Only used by the worker
+  LevelValidator m_validator;
+  std::atomic<unsigned int> m_revision;
+};
+
+#endif
@@ -14,7 +14,8 @@ CreateLevelGraphicsView::CreateLevelGraphicsView(QWidget* p_parent):
   m_scene(nullptr),
   m_gridPixmapItem(nullptr),
   m_rectangleSelectionItem(new GraphicsRectangleSelectionItem),
-  m_viewInitialized(false) {
+  m_viewInitialized(false),
+  m_highlightedLines() {
 
   setMouseTracking(true);
 }
@@ -89,6 +90,27 @@ void CreateLevelGraphicsView::UpdateView() {
   m_scene->update();
 }
 
+void CreateLevelGraphicsView::SetHighlightedLines(QList<QLineF> const& p_lines) {
+  if (p_lines == m_highlightedLines) {
+    return;
+  }
+  m_highlightedLines = p_lines;
+  viewport()->update();
+}
+
+void CreateLevelGraphicsView::drawForeground(QPainter* p_painter, QRectF const& p_rect) {
+  QGraphicsView::drawForeground(p_painter, p_rect);
+  if (m_highlightedLines.isEmpty()) {
+    return;
+  }
+
+  p_painter->save();
+  p_painter->setRenderHint(QPainter::Antialiasing);
+  p_painter->setPen(QPen(QColor("#e53935"), 3, Qt::SolidLine, Qt::RoundCap));
+  p_painter->drawLines(m_highlightedLines);
+  p_painter->restore();
+}
+
 void CreateLevelGraphicsView::AddGraphicsItem(QGraphicsItem* p_graphicsItem) {
   m_scene->addItem(p_graphicsItem);
 }
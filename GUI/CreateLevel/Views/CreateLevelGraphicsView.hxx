@@ -6,6 +6,7 @@
 #include "Core/Geometry/Polygon.hxx"
 
 #include <QGraphicsView>
+#include <QLineF>
 
 class GraphicsObjectItem;
 class GraphicsRectangleSelectionItem;
@@ -29,6 +30,9 @@ public:
   void SetRubberBandDragMode(bool p_rubberBandOn);
   void SetSelectionArea(const QRect& p_rect);
 
+  // Drawn over the level, e.g. to point out crossing edges
+  void SetHighlightedLines(QList<QLineF> const& p_lines);
+
 Q_SIGNALS:
   void SnappedToGrid();
   void NewLevelRequested();
@@ -48,12 +52,14 @@ protected:
   void mouseMoveEvent(QMouseEvent* p_event) override;
   void mouseReleaseEvent(QMouseEvent* p_event) override;
   void keyPressEvent(QKeyEvent* p_event) override;
+  void drawForeground(QPainter* p_painter, QRectF const& p_rect) override;
 
 private:
   QGraphicsScene* m_scene;
   QGraphicsPixmapItem* m_gridPixmapItem;
   GraphicsRectangleSelectionItem* m_rectangleSelectionItem;
   bool m_viewInitialized;
+  QList<QLineF> m_highlightedLines;
 };
 
 #endif
@@ -113,6 +113,11 @@ CreateLevelWidget::CreateLevelWidget(QWidget* parent):
   addAction(openAction);
   connect(openAction, &QAction::triggered, this, &CreateLevelWidget::ConfirmOpenLevel);
 
+  auto saveAction = new QAction("Save level", this);
+  saveAction->setShortcut(QKeySequence::Save);
+  addAction(saveAction);
+  connect(saveAction, &QAction::triggered, this, &CreateLevelWidget::ChooseSaveLevel);
+
   // Graphics View signals forward
   connect(m_graphicsView, &CreateLevelGraphicsView::MousePressed, this, &CreateLevelWidget::MousePressed);
   connect(m_graphicsView, &CreateLevelGraphicsView::MouseMoved, this, &CreateLevelWidget::MouseMoved);
@@ -355,6 +360,14 @@ void CreateLevelWidget::SetTestAvailable(bool p_enable)
   m_testLevelButton->setEnabled(p_enable);
 }
 
+void CreateLevelWidget::SetHighlightedLines(QList<QLineF> const& p_lines) {
+  m_graphicsView->SetHighlightedLines(p_lines);
+}
+
+void CreateLevelWidget::ShowSaveError(QString const& p_fileName) {
+  QMessageBox::warning(this, tr("Save"), tr("The level could not be saved to %1.").arg(p_fileName));
+}
+
 void CreateLevelWidget::UpdateView() {
   m_graphicsView->UpdateView();
 }
@@ -372,9 +385,16 @@ void CreateLevelWidget::ConfirmNewLevel() {
 
 void CreateLevelWidget::ConfirmOpenLevel() {
   if (ConfirmClear()) {
-    auto fileName = QFileDialog::getOpenFileName(this, "Open level", ":/world1", "POLYPIXEL Files (*.ppxl)");
+    auto fileName = QFileDialog::getOpenFileName(this, "Open level", ":/world1", "POLYPIXEL Files (*.ppxl *.ppxlb)");
     if (!fileName.isEmpty()) {
       Q_EMIT OpenLevelRequested(fileName);
     }
   }
 }
+
+void CreateLevelWidget::ChooseSaveLevel() {
+  auto fileName = QFileDialog::getSaveFileName(this, "Save level", QString(), "POLYPIXEL Files (*.ppxl *.ppxlb)");
+  if (!fileName.isEmpty()) {
+    Q_EMIT SaveLevelRequested(fileName);
+  }
+}
@@ -1,6 +1,7 @@
 #ifndef CREATELEVELWIDGET_HXX
 #define CREATELEVELWIDGET_HXX
 
+#include <QLineF>
 #include <QWidget>
 
 #include "Core/Geometry/Point.hxx"
@@ -66,6 +67,8 @@ public:
   void ClearImage();
 
   void SetTestAvailable(bool p_enable);
+  void SetHighlightedLines(QList<QLineF> const& p_lines);
+  void ShowSaveError(QString const& p_fileName);
 
   void ShowDetailListView();
   void ShowVertexListView();
@@ -86,6 +89,7 @@ Q_SIGNALS:
   void SnapAllToGridRequested();
   void NewLevelRequested();
   void OpenLevelRequested(QString const& p_fileName);
+  void SaveLevelRequested(QString const& p_fileName);
   void MousePressed(QMouseEvent* p_event);
   void MouseMoved(QMouseEvent* p_event);
   void MouseReleased(QMouseEvent* p_event);
@@ -113,6 +117,7 @@ protected:
   bool ConfirmClear();
   void ConfirmNewLevel();
   void ConfirmOpenLevel();
+  void ChooseSaveLevel();
 
 private:
   QLabel* m_createLevelLabel;
@@ -13,10 +13,9 @@
 TestLevelController::TestLevelController(TestLevelWidget* p_testLevelWidget, QObject* p_parent):
   QObject(p_parent),
   m_testLevelWidget(p_testLevelWidget),
-  m_polygonsList(),
   m_objectsList(),
   m_slicer(),
-  m_graphicsPolygonItemsList(),
+  m_graphicsPolygonItemsMap(),
   m_polygonsColor(),
   m_colorPicked(false) {
 
@@ -42,16 +41,15 @@ void TestLevelController::SetTolerance(int Tolerance) {
 }
 
 void TestLevelController::InitPolygonsList(std::vector<ppxl::Polygon*> const& p_polygonsList) {
+  std::vector<ppxl::Polygon> polygonsList;
   for (auto polygon: p_polygonsList) {
-    m_polygonsList.push_back(*polygon);
+    polygonsList.push_back(*polygon);
   }
-  m_slicer.SetPolygonsList(m_polygonsList);
+  m_slicer.SetPolygonsList(polygonsList);
 }
 
 void TestLevelController::SetPolygonsList(const std::vector<ppxl::Polygon>& p_polygonsList) {
-  m_polygonsList.clear();
-  m_polygonsList = p_polygonsList;
-  m_slicer.SetPolygonsList(m_polygonsList);
+  m_slicer.SetPolygonsList(p_polygonsList);
 }
 
 void TestLevelController::SetObjectModelsList(std::vector<Object*> const& p_objectsList) {
@@ -65,25 +63,46 @@ void TestLevelController::PlayLevel() {
 }
 
 void TestLevelController::SetPolygonItems() {
-  for (auto polygonItem: m_graphicsPolygonItemsList) {
+  for (auto polygonItem: m_graphicsPolygonItemsMap) {
     polygonItem->DeletePolygon();
     delete polygonItem;
   }
-  m_graphicsPolygonItemsList.clear();
-
-  for (auto polygon: m_polygonsList) {
-    auto polygonItem = new GraphicsPolygonItem(new ppxl::Polygon(polygon));
-    if (m_colorPicked) {
-      polygonItem->SetColor(m_polygonsColor);
-    } else {
-      m_polygonsColor = polygonItem->GetColor();
-      m_colorPicked = true;
+  m_graphicsPolygonItemsMap.clear();
+
+  auto const& polygonsList = m_slicer.GetPolygonsList();
+  auto const& polygonsIds = m_slicer.GetPolygonsIds();
+  for (unsigned int k = 0; k < polygonsList.size(); ++k) {
+    AddPolygonItem(polygonsIds.at(k), polygonsList.at(k));
+  }
+}
+
+void TestLevelController::UpdatePolygonItems(Slicer::PolygonsChangeSet const& p_changeSet) {
+  // Items of the polygons the cut did not touch are left as they are
+  for (auto polygonId: p_changeSet.m_removedIds) {
+    auto polygonItem = m_graphicsPolygonItemsMap.take(polygonId);
+    if (polygonItem) {
+      polygonItem->DeletePolygon();
+      delete polygonItem;
     }
-    m_graphicsPolygonItemsList.push_back(polygonItem);
-    m_testLevelWidget->AddGraphicsItem(polygonItem);
+  }
+
+  for (unsigned int k = 0; k < p_changeSet.m_addedIds.size(); ++k) {
+    AddPolygonItem(p_changeSet.m_addedIds.at(k), p_changeSet.m_addedPolygons.at(k));
   }
 }
 
+void TestLevelController::AddPolygonItem(Slicer::PolygonId p_polygonId, ppxl::Polygon const& p_polygon) {
+  auto polygonItem = new GraphicsPolygonItem(new ppxl::Polygon(p_polygon));
+  if (m_colorPicked) {
+    polygonItem->SetColor(m_polygonsColor);
+  } else {
+    m_polygonsColor = polygonItem->GetColor();
+    m_colorPicked = true;
+  }
+  m_graphicsPolygonItemsMap.insert(p_polygonId, polygonItem);
+  m_testLevelWidget->AddGraphicsItem(polygonItem);
+}
+
 void TestLevelController::SetObjectItems() {
   for (auto object: m_objectsList) {
     switch (object->GetObjectType()) {
@@ -111,7 +130,7 @@ void TestLevelController::MousePressEvent(QMouseEvent* p_event) {
 }
 
 void TestLevelController::MouseMoveEvent(QMouseEvent* p_event) {
-  auto lines = m_slicer.ComputeSlicingLines(ppxl::Point(p_event->pos().x(), p_event->pos().y()));
+  auto const& lines = m_slicer.ComputeSlicingLines(ppxl::Point(p_event->pos().x(), p_event->pos().y()));
   switch (m_slicer.ComputeLinesType(lines)) {
   case Slicer::eGoodCrossing: {
     m_testLevelWidget->SetGoodCutState();
@@ -129,9 +148,10 @@ void TestLevelController::MouseMoveEvent(QMouseEvent* p_event) {
 }
 
 void TestLevelController::MouseReleaseEvent(QMouseEvent* p_event) {
-  m_slicer.SliceIt(ppxl::Point(p_event->pos().x(), p_event->pos().y()));
-  SetPolygonsList(m_slicer.GetPolygonsList());
-  SetPolygonItems();
+  Slicer::PolygonsChangeSet changeSet;
+  if (m_slicer.SliceIt(ppxl::Point(p_event->pos().x(), p_event->pos().y()), changeSet)) {
+    UpdatePolygonItems(changeSet);
+  }
 
   m_testLevelWidget->SetCuttingLines({});
   m_testLevelWidget->CuttingEnded();
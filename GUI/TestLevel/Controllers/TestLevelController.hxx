@@ -5,6 +5,7 @@
 
 #include <QObject>
 #include <QColor>
+#include <QMap>
 
 class TestLevelWidget;
 class Object;
@@ -38,14 +39,15 @@ Q_SIGNALS:
 
 protected:
   void SetPolygonItems();
+  void UpdatePolygonItems(Slicer::PolygonsChangeSet const& p_changeSet);
+  void AddPolygonItem(Slicer::PolygonId p_polygonId, ppxl::Polygon const& p_polygon);
   void SetObjectItems();
 
 private:
   TestLevelWidget* m_testLevelWidget;
-  std::vector<ppxl::Polygon> m_polygonsList;
   std::vector<Object*> m_objectsList;
   Slicer m_slicer;
-  std::vector<GraphicsPolygonItem*> m_graphicsPolygonItemsList;
+  QMap<Slicer::PolygonId, GraphicsPolygonItem*> m_graphicsPolygonItemsMap;
   QColor m_polygonsColor;
   bool m_colorPicked;
 };
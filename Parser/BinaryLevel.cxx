@@ -0,0 +1,303 @@
+#include "BinaryLevel.hxx"
+
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr char Magic[8] = {'P', 'P', 'X', 'L', 'B', 'I', 'N', '\0'};
+constexpr qint64 HeaderSize = 64;
+constexpr qint64 VersionOffset = 8;
+constexpr qint64 FlagsOffset = 10;
+constexpr qint64 GoalsOffset = 12;
+constexpr qint64 CountsOffset = 32;
+constexpr int GoalsCount = 5;
+
+enum Count {
+  ePolygonsCount,
+  eVerticesCount,
+  eTapesCount,
+  eOneWaysCount,
+  eMirrorsCount,
+  ePortalsCount,
+  eCountsCount
+};
+
+constexpr qint64 ValuesPerTape = 4;
+constexpr qint64 ValuesPerOneWay = 4;
+constexpr qint64 ValuesPerMirror = 4;
+constexpr qint64 ValuesPerPortal = 8;
+
+qint64 Align(qint64 p_offset) {
+  return (p_offset + 7) & ~qint64(7);
+}
+
+// Where each section starts, from the header's counts
+struct Layout {
+  Layout(qint64 const* p_counts, bool p_integerCoordinates) {
+    qint64 coordinateSize = p_integerCoordinates ? sizeof(qint32) : sizeof(double);
+    qint64 objectValuesCount = ValuesPerTape*p_counts[eTapesCount] + ValuesPerOneWay*p_counts[eOneWaysCount]
+      + ValuesPerMirror*p_counts[eMirrorsCount] + ValuesPerPortal*p_counts[ePortalsCount];
+
+    m_polygonsOffset = HeaderSize;
+    m_verticesOffset = Align(m_polygonsOffset + qint64(sizeof(quint32))*p_counts[ePolygonsCount]);
+    m_objectsOffset = Align(m_verticesOffset + 2*coordinateSize*p_counts[eVerticesCount]);
+    m_size = Align(m_objectsOffset + coordinateSize*objectValuesCount);
+  }
+
+  qint64 m_polygonsOffset;
+  qint64 m_verticesOffset;
+  qint64 m_objectsOffset;
+  qint64 m_size;
+};
+
+void WriteDouble(double p_value, uchar* p_destination) {
+  quint64 bits;
+  std::memcpy(&bits, &p_value, sizeof(bits));
+  qToLittleEndian(bits, p_destination);
+}
+
+double ReadDouble(uchar const* p_source) {
+  quint64 bits = qFromLittleEndian<quint64>(p_source);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void WriteCoordinates(std::vector<double> const& p_values, bool p_integerCoordinates, uchar* p_destination) {
+  for (std::size_t k = 0; k < p_values.size(); ++k) {
+    if (p_integerCoordinates) {
+      qToLittleEndian(static_cast<qint32>(p_values[k]), p_destination + sizeof(qint32)*k);
+    } else {
+      WriteDouble(p_values[k], p_destination + sizeof(double)*k);
+    }
+  }
+}
+
+bool AreIntegers(std::vector<double> const& p_values) {
+  for (double value: p_values) {
+    if (value != std::trunc(value) || value < std::numeric_limits<qint32>::min() || value > std::numeric_limits<qint32>::max()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void AppendSegment(ppxl::Segment const& p_segment, std::vector<double>& p_values) {
+  p_values.insert(p_values.end(), {p_segment.GetA().GetX(), p_segment.GetA().GetY(), p_segment.GetB().GetX(), p_segment.GetB().GetY()});
+}
+
+// Reads the coordinates of a section one after the other
+class CoordinatesReader {
+public:
+  CoordinatesReader(uchar const* p_data, bool p_integerCoordinates):
+    m_data(p_data),
+    m_integerCoordinates(p_integerCoordinates) {
+  }
+
+  double Next() {
+    double value;
+    if (m_integerCoordinates) {
+      value = qFromLittleEndian<qint32>(m_data);
+      m_data += sizeof(qint32);
+    } else {
+      value = ReadDouble(m_data);
+      m_data += sizeof(double);
+    }
+    return value;
+  }
+
+private:
+  uchar const* m_data;
+  bool m_integerCoordinates;
+};
+
+}
+
+QByteArray BinaryLevel::Encode(Level const& p_level, bool p_compact) {
+  std::vector<quint32> polygonsEnds;
+  std::vector<double> verticesValues;
+  for (auto const& polygon: p_level.m_polygonsList) {
+    for (auto const& vertex: polygon.GetVertices()) {
+      verticesValues.push_back(vertex.GetX());
+      verticesValues.push_back(vertex.GetY());
+    }
+    polygonsEnds.push_back(static_cast<quint32>(verticesValues.size()/2));
+  }
+
+  // Tapes are stored as Serializer writes them, and built back as Parser does
+  std::vector<double> objectsValues;
+  for (auto const& tape: p_level.m_tapesList) {
+    objectsValues.insert(objectsValues.end(), {tape.GetXmin(), tape.GetYmin(), tape.GetW(), tape.GetH()});
+  }
+  for (auto const& oneWay: p_level.m_oneWaysList) {
+    AppendSegment(oneWay.GetLine(), objectsValues);
+  }
+  for (auto const& mirror: p_level.m_mirrorsList) {
+    AppendSegment(mirror.GetLine(), objectsValues);
+  }
+  for (auto const& portal: p_level.m_portalsList) {
+    AppendSegment(portal.GetIn(), objectsValues);
+    AppendSegment(portal.GetOut(), objectsValues);
+  }
+
+  bool integerCoordinates = p_compact && AreIntegers(verticesValues) && AreIntegers(objectsValues);
+  qint64 counts[eCountsCount] = {
+    p_level.m_polygonsList.size(),
+    static_cast<qint64>(verticesValues.size()/2),
+    p_level.m_tapesList.size(),
+    p_level.m_oneWaysList.size(),
+    p_level.m_mirrorsList.size(),
+    p_level.m_portalsList.size()
+  };
+  Layout layout(counts, integerCoordinates);
+
+  QByteArray bytes(static_cast<int>(layout.m_size), '\0');
+  auto data = reinterpret_cast<uchar*>(bytes.data());
+
+  std::memcpy(data, Magic, sizeof(Magic));
+  qToLittleEndian(Version, data + VersionOffset);
+  qToLittleEndian(static_cast<quint16>(integerCoordinates ? eIntegerCoordinates : 0), data + FlagsOffset);
+  qint32 goals[GoalsCount] = {p_level.m_linesGoal, p_level.m_partsGoal, p_level.m_maxGapToWin, p_level.m_tolerance, p_level.m_starsCount};
+  for (int k = 0; k < GoalsCount; ++k) {
+    qToLittleEndian(goals[k], data + GoalsOffset + sizeof(qint32)*k);
+  }
+  for (int k = 0; k < eCountsCount; ++k) {
+    qToLittleEndian(static_cast<quint32>(counts[k]), data + CountsOffset + sizeof(quint32)*k);
+  }
+
+  for (std::size_t k = 0; k < polygonsEnds.size(); ++k) {
+    qToLittleEndian(polygonsEnds[k], data + layout.m_polygonsOffset + sizeof(quint32)*k);
+  }
+  WriteCoordinates(verticesValues, integerCoordinates, data + layout.m_verticesOffset);
+  WriteCoordinates(objectsValues, integerCoordinates, data + layout.m_objectsOffset);
+
+  return bytes;
+}
+
+bool BinaryLevel::Decode(uchar const* p_data, qint64 p_size, Level& p_level) {
+  if (p_size < HeaderSize || std::memcmp(p_data, Magic, sizeof(Magic)) != 0) {
+    return false;
+  }
+  if (qFromLittleEndian<quint16>(p_data + VersionOffset) != Version) {
+    return false;
+  }
+
+  bool integerCoordinates = qFromLittleEndian<quint16>(p_data + FlagsOffset) & eIntegerCoordinates;
+  qint64 counts[eCountsCount];
+  for (int k = 0; k < eCountsCount; ++k) {
+    counts[k] = qFromLittleEndian<quint32>(p_data + CountsOffset + sizeof(quint32)*k);
+  }
+  Layout layout(counts, integerCoordinates);
+  if (layout.m_size != p_size) {
+    return false;
+  }
+
+  // Check polygons first, so that a corrupted file leaves p_level untouched
+  uchar const* polygonsEnds = p_data + layout.m_polygonsOffset;
+  quint32 previousEnd = 0;
+  for (qint64 k = 0; k < counts[ePolygonsCount]; ++k) {
+    quint32 end = qFromLittleEndian<quint32>(polygonsEnds + sizeof(quint32)*k);
+    if (end < previousEnd || end > counts[eVerticesCount]) {
+      return false;
+    }
+    previousEnd = end;
+  }
+
+  Level level;
+  qint32* goals[GoalsCount] = {&level.m_linesGoal, &level.m_partsGoal, &level.m_maxGapToWin, &level.m_tolerance, &level.m_starsCount};
+  for (int k = 0; k < GoalsCount; ++k) {
+    *goals[k] = qFromLittleEndian<qint32>(p_data + GoalsOffset + sizeof(qint32)*k);
+  }
+
+  // Double vertices are laid out as ppxl::Point: on little-endian machines they are copied as a whole
+  bool copyVertices = !integerCoordinates && QSysInfo::ByteOrder == QSysInfo::LittleEndian;
+  uchar const* verticesData = p_data + layout.m_verticesOffset;
+  CoordinatesReader verticesReader(verticesData, integerCoordinates);
+  level.m_polygonsList.reserve(static_cast<int>(counts[ePolygonsCount]));
+  quint32 begin = 0;
+  for (qint64 k = 0; k < counts[ePolygonsCount]; ++k) {
+    quint32 end = qFromLittleEndian<quint32>(polygonsEnds + sizeof(quint32)*k);
+    std::vector<ppxl::Point> vertices(end - begin);
+    if (copyVertices) {
+      std::memcpy(vertices.data(), verticesData + sizeof(ppxl::Point)*begin, sizeof(ppxl::Point)*vertices.size());
+    } else {
+      for (auto& vertex: vertices) {
+        double x = verticesReader.Next();
+        vertex = ppxl::Point(x, verticesReader.Next());
+      }
+    }
+    level.m_polygonsList << ppxl::Polygon(vertices);
+    begin = end;
+  }
+
+  CoordinatesReader objectsReader(p_data + layout.m_objectsOffset, integerCoordinates);
+  double values[ValuesPerPortal];
+  auto readValues = [&objectsReader, &values](qint64 p_count) {
+    for (qint64 k = 0; k < p_count; ++k) {
+      values[k] = objectsReader.Next();
+    }
+  };
+  for (qint64 k = 0; k < counts[eTapesCount]; ++k) {
+    readValues(ValuesPerTape);
+    level.m_tapesList << Tape(values[0], values[1], values[2], values[3]);
+  }
+  for (qint64 k = 0; k < counts[eOneWaysCount]; ++k) {
+    readValues(ValuesPerOneWay);
+    level.m_oneWaysList << OneWay(values[0], values[1], values[2], values[3]);
+  }
+  for (qint64 k = 0; k < counts[eMirrorsCount]; ++k) {
+    readValues(ValuesPerMirror);
+    level.m_mirrorsList << Mirror(values[0], values[1], values[2], values[3]);
+  }
+  for (qint64 k = 0; k < counts[ePortalsCount]; ++k) {
+    readValues(ValuesPerPortal);
+    level.m_portalsList << Portal(values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7]);
+  }
+
+  p_level = level;
+  return true;
+}
+
+bool BinaryLevel::Write(Level const& p_level, QString const& p_fileName, bool p_compact) {
+  QSaveFile file(p_fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    qDebug() << "Cannot open binary level file in BinaryLevel::Write\n" << file.errorString();
+    return false;
+  }
+
+  QByteArray bytes = Encode(p_level, p_compact);
+  return file.write(bytes) == bytes.size() && file.commit();
+}
+
+bool BinaryLevel::Read(QString const& p_fileName, Level& p_level) {
+  QFile file(p_fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    qDebug() << "Cannot open binary level file in BinaryLevel::Read\n" << file.errorString();
+    return false;
+  }
+
+  bool decoded = false;
+  qint64 size = file.size();
+  if (uchar* data = file.map(0, size)) {
+    decoded = Decode(data, size, p_level);
+    file.unmap(data);
+  } else {
+    // Some file systems cannot be mapped
+    QByteArray bytes = file.readAll();
+    decoded = Decode(reinterpret_cast<uchar const*>(bytes.constData()), bytes.size(), p_level);
+  }
+  file.close();
+
+  if (!decoded) {
+    qDebug() << "Corrupted binary level file in BinaryLevel::Read:" << p_fileName;
+  }
+  return decoded;
+}
@@ -0,0 +1,36 @@
+#ifndef BINARYLEVEL_HXX
+#define BINARYLEVEL_HXX
+
+#include <QByteArray>
+#include <QString>
+
+#include "Parser/Level.hxx"
+
+// Compact counterpart of the .ppxl files, memory-mapped when read. Little-endian layout:
+//   header       magic "PPXLBIN\0", quint16 version, quint16 flags, qint32 goals[5] (lines, parts,
+//                max gap to win, tolerance, stars), quint32 counts[6] (polygons, vertices, tapes,
+//                one-ways, mirrors, portals), padding up to 64 bytes
+//   polygons     quint32 end of each polygon in the vertex array
+//   vertices     x, y of every vertex
+//   objects      tapes (x, y, w, h), one-ways and mirrors (xa, ya, xb, yb), portals (in, then out)
+// Coordinates are doubles, unless the eIntegerCoordinates flag is set. Every section starts on
+// 8 bytes, so that double vertices are copied into the polygons as they are stored.
+class BinaryLevel {
+public:
+  enum Flag {
+    eIntegerCoordinates = 1 << 0
+  };
+
+  static constexpr char const* Suffix = "ppxlb";
+  static constexpr quint16 Version = 1;
+
+  // p_compact stores coordinates as qint32 when all of them are integral: files are about half
+  // the size, but each coordinate is then converted when read instead of copied
+  static QByteArray Encode(Level const& p_level, bool p_compact = false);
+  static bool Decode(uchar const* p_data, qint64 p_size, Level& p_level);
+
+  static bool Write(Level const& p_level, QString const& p_fileName, bool p_compact = false);
+  static bool Read(QString const& p_fileName, Level& p_level);
+};
+
+#endif
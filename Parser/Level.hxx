@@ -0,0 +1,34 @@
+#ifndef LEVEL_HXX
+#define LEVEL_HXX
+
+#include <QList>
+
+#include "Core/Geometry/Polygon.hxx"
+#include "Core/Objects/Obstacles/Tape.hxx"
+#include "Core/Objects/Obstacles/OneWay.hxx"
+#include "Core/Objects/Deviations/Mirror.hxx"
+#include "Core/Objects/Deviations/Portal.hxx"
+
+using PolygonsList = QList<ppxl::Polygon>;
+using TapesList = QList<Tape>;
+using OneWaysList = QList<OneWay>;
+using MirrorsList = QList<Mirror>;
+using PortalsList = QList<Portal>;
+
+// What a level file describes. Polygons and objects are sorted by id, and a goal that is not
+// given exactly once is -1.
+struct Level {
+  int m_linesGoal = -1;
+  int m_partsGoal = -1;
+  int m_maxGapToWin = -1;
+  int m_tolerance = -1;
+  int m_starsCount = -1;
+
+  PolygonsList m_polygonsList;
+  TapesList m_tapesList;
+  OneWaysList m_oneWaysList;
+  MirrorsList m_mirrorsList;
+  PortalsList m_portalsList;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "LevelIOService.hxx"
+
+#include "Parser/BinaryLevel.hxx"
+#include "Parser/Parser.hxx"
+#include "Parser/Serializer.hxx"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+
+LevelIOService::LevelIOService(QObject* p_parent):
+  QObject(p_parent),
+  m_thread(),
+  m_worker(new QObject),
+  m_workerLatencies() {
+
+  m_thread.setObjectName("LevelIOService");
+  m_worker->moveToThread(&m_thread);
+  m_thread.start();
+}
+
+LevelIOService::~LevelIOService() {
+  QMetaObject::invokeMethod(m_worker, []() {}, Qt::BlockingQueuedConnection);
+  m_thread.quit();
+  m_thread.wait();
+  delete m_worker;
+}
+
+void LevelIOService::Load(QString const& p_fileName) {
+  QMetaObject::invokeMethod(m_worker, [this, p_fileName]() {
+    QElapsedTimer timer;
+    timer.start();
+    Level level = Parser(p_fileName).GetLevel();
+    m_workerLatencies.Record(timer.nsecsElapsed()/1000.);
+
+    QMetaObject::invokeMethod(this, [this, p_fileName, level]() {
+      Q_EMIT LevelLoaded(p_fileName, level);
+    }, Qt::QueuedConnection);
+  }, Qt::QueuedConnection);
+}
+
+void LevelIOService::Save(Level const& p_level, QString const& p_fileName) {
+  QMetaObject::invokeMethod(m_worker, [this, p_level, p_fileName]() {
+    QElapsedTimer timer;
+    timer.start();
+    bool saved = QFileInfo(p_fileName).suffix() == BinaryLevel::Suffix ?
+      BinaryLevel::Write(p_level, p_fileName):
+      Serializer::WriteLevel(p_level, p_fileName);
+    m_workerLatencies.Record(timer.nsecsElapsed()/1000.);
+
+    QMetaObject::invokeMethod(this, [this, p_fileName, saved]() {
+      Q_EMIT LevelSaved(p_fileName, saved);
+    }, Qt::QueuedConnection);
+  }, Qt::QueuedConnection);
+}
@@ -0,0 +1,37 @@
+#ifndef LEVELIOSERVICE_HXX
+#define LEVELIOSERVICE_HXX
+
+#include <QObject>
+#include <QThread>
+
+#include "Core/LatencyHistogram.hxx"
+#include "Parser/Level.hxx"
+
+// Loads and saves levels on a worker thread, one request after the other, and delivers the results
+// through queued signals. .ppxlb files go through BinaryLevel, any other one is XML.
+class LevelIOService: public QObject {
+  Q_OBJECT
+
+public:
+  explicit LevelIOService(QObject* p_parent = nullptr);
+  // Waits for the pending requests, so that no save is lost on exit
+  ~LevelIOService() override;
+
+  void Load(QString const& p_fileName);
+  // p_level is a snapshot: its lists are implicitly shared, so that handing it over copies nothing
+  void Save(Level const& p_level, QString const& p_fileName);
+
+  // Time the worker spends on each request, reading or writing included
+  inline LatencyHistogram const& GetWorkerLatencies() const { return m_workerLatencies; }
+
+Q_SIGNALS:
+  void LevelLoaded(QString const& p_fileName, Level const& p_level);
+  void LevelSaved(QString const& p_fileName, bool p_saved);
+
+private:
+  QThread m_thread;
+  QObject* m_worker;
+  LatencyHistogram m_workerLatencies;
+};
+
+#endif
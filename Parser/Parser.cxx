@@ -1,241 +1,225 @@
 #include "Parser.hxx"
 
+#include "Parser/BinaryLevel.hxx"
+#include "Core/Trace.hxx"
+
 #include <QFile>
+#include <QFileInfo>
 #include <QDebug>
+#include <QXmlStreamReader>
 
-Parser::Parser(QString const& p_xmlFileName):
-  m_xmlFileName(p_xmlFileName),
-  m_doc(QDomDocument("PPXLML")) {
+#include <algorithm>
+#include <numeric>
+#include <vector>
 
-  QFile XMLDoc(m_xmlFileName);
-  if(!XMLDoc.open(QIODevice::ReadOnly | QIODevice::Text)) {
-    qDebug() << "Cannot open XML file in Parser::Parser(QString xmlFileName)";
-    return;
-  }
+namespace {
 
-  if(!m_doc.setContent(&XMLDoc)) {
-    XMLDoc.close();
-    qDebug() << "Cannot set content of dom in Parser::Parser(QString xmlFileName)";
+// Files written by Serializer list their elements by increasing id: only other files are reordered
+template<typename T>
+void SortById(QList<T>& p_list, std::vector<int> const& p_ids) {
+  if (std::is_sorted(p_ids.begin(), p_ids.end())) {
     return;
   }
 
-  m_polygons = m_doc.firstChildElement("level").firstChildElement("polygons");
-  m_tapes = m_doc.firstChildElement("level").firstChildElement("objects").firstChildElement("obstacles").firstChildElement("tapes");
-  m_oneWays = m_doc.firstChildElement("level").firstChildElement("objects").firstChildElement("obstacles").firstChildElement("oneways");
-  m_mirrors = m_doc.firstChildElement("level").firstChildElement("objects").firstChildElement("deviations").firstChildElement("mirrors");
-  m_portals = m_doc.firstChildElement("level").firstChildElement("objects").firstChildElement("deviations").firstChildElement("portals");
+  std::vector<int> order(p_ids.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&p_ids](int p_left, int p_right) {
+    return p_ids[p_left] < p_ids[p_right];
+  });
 
-  m_polygonNodesCount = m_polygons.elementsByTagName("polygon").count();
-  m_tapeNodesCount = m_tapes.elementsByTagName("tape").count();
-  m_oneWayNodesCount = m_oneWays.elementsByTagName("oneway").count();
-  m_mirrorNodesCount = m_mirrors.elementsByTagName("mirror").count();
-  m_portalNodesCount = m_portals.elementsByTagName("portal").count();
+  QList<T> sortedList;
+  sortedList.reserve(p_list.size());
+  for (int index: order) {
+    sortedList << p_list.at(index);
+  }
+  p_list.swap(sortedList);
+}
 
-  XMLDoc.close();
 }
 
-Parser::~Parser() = default;
+Parser::Parser(QString const& p_xmlFileName):
+  m_xmlFileName(p_xmlFileName),
+  m_level() {
 
+  if (QFileInfo(m_xmlFileName).suffix() == BinaryLevel::Suffix) {
+    BinaryLevel::Read(m_xmlFileName, m_level);
+    TraceLevel();
+    return;
+  }
 
-// Primitives
+  QFile XMLDoc(m_xmlFileName);
+  if(!XMLDoc.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    qDebug() << "Cannot open XML file in Parser::Parser(QString xmlFileName)";
+    return;
+  }
 
-int Parser::GetInt(QDomElement const& p_element, QString const& attributeName) const {
-  return p_element.attribute(attributeName).toInt();
-}
+  QXmlStreamReader reader(&XMLDoc);
+  ReadLevel(reader);
+  if (reader.hasError()) {
+    qDebug() << "Cannot read XML file in Parser::Parser(QString xmlFileName):" << reader.errorString() << "at line" << reader.lineNumber();
+    m_level = Level();
+  }
+  TraceLevel();
 
-double Parser::GetDouble(QDomElement const& p_element, QString const& p_attributeName) const {
-  return p_element.attribute(p_attributeName).toDouble();
+  XMLDoc.close();
 }
 
-int Parser::GetIntValue(QString const& p_tagName, QString const& p_attributeName) const {
-  QDomNodeList nodeList = m_doc.elementsByTagName(p_tagName);
-  if (nodeList.size() != 1)
-    return -1;
+Parser::~Parser() = default;
 
-  QDomElement const& element = nodeList.at(0).toElement();
-  return GetInt(element, p_attributeName);
-}
+void Parser::TraceLevel() const {
+  PPXL_TRACE(eParser, m_xmlFileName.toStdString() << ": " << m_level.m_polygonsList.size() << " polygons, " << m_level.m_tapesList.size() << " tapes, "
+    << m_level.m_oneWaysList.size() << " one-ways, " << m_level.m_mirrorsList.size() << " mirrors, " << m_level.m_portalsList.size() << " portals");
+}
+
+void Parser::ReadLevel(QXmlStreamReader& p_reader) {
+  std::vector<int> polygonsIds;
+  std::vector<int> tapesIds;
+  std::vector<int> oneWaysIds;
+  std::vector<int> mirrorsIds;
+  std::vector<int> portalsIds;
+
+  struct Goal {
+    QString m_tagName;
+    int* m_value;
+    int m_count;
+  };
+  Goal goals[] = {
+    {"linesgoal", &m_level.m_linesGoal, 0},
+    {"partsgoal", &m_level.m_partsGoal, 0},
+    {"maxgaptowin", &m_level.m_maxGapToWin, 0},
+    {"tolerance", &m_level.m_tolerance, 0},
+    {"starscount", &m_level.m_starsCount, 0}
+  };
+
+  while (!p_reader.atEnd()) {
+    if (p_reader.readNext() != QXmlStreamReader::StartElement) {
+      continue;
+    }
 
-QDomElement Parser::GetElementById(QDomElement const& p_parent, QString const& p_name, int p_id) const  {
-  QDomNodeList nodeList = p_parent.elementsByTagName(p_name);
-  for (int k = 0; k < nodeList.size(); k++) {
-    QDomElement element = nodeList.at(k).toElement();
-    if (element.attribute("id").toInt() == p_id) {
-      return element;
+    auto name = p_reader.name();
+    QXmlStreamAttributes attributes = p_reader.attributes();
+    if (name == QLatin1String("polygon")) {
+      polygonsIds.push_back(GetInt(attributes, "id"));
+      m_level.m_polygonsList << ReadPolygon(p_reader);
+    } else if (name == QLatin1String("tape")) {
+      tapesIds.push_back(GetInt(attributes, "id"));
+      m_level.m_tapesList << GetTape(attributes);
+    } else if (name == QLatin1String("oneway")) {
+      oneWaysIds.push_back(GetInt(attributes, "id"));
+      m_level.m_oneWaysList << GetOneWay(attributes);
+    } else if (name == QLatin1String("mirror")) {
+      mirrorsIds.push_back(GetInt(attributes, "id"));
+      m_level.m_mirrorsList << GetMirror(attributes);
+    } else if (name == QLatin1String("portal")) {
+      portalsIds.push_back(GetInt(attributes, "id"));
+      m_level.m_portalsList << GetPortal(attributes);
+    } else {
+      for (auto& goal: goals) {
+        if (name == goal.m_tagName) {
+          *goal.m_value = GetInt(attributes, "value");
+          ++goal.m_count;
+          break;
+        }
+      }
     }
   }
 
-  qDebug() << "Error: cannot find element " << p_name << " with number" << QString::number(p_id);
-  return QDomElement();
-}
-
-
-// Game Infos
+  for (auto const& goal: goals) {
+    if (goal.m_count != 1) {
+      *goal.m_value = -1;
+    }
+  }
 
-int Parser::GetPartsGoal() const {
-  return GetIntValue("partsgoal");
+  SortById(m_level.m_polygonsList, polygonsIds);
+  SortById(m_level.m_tapesList, tapesIds);
+  SortById(m_level.m_oneWaysList, oneWaysIds);
+  SortById(m_level.m_mirrorsList, mirrorsIds);
+  SortById(m_level.m_portalsList, portalsIds);
 }
 
-int Parser::GetLinesGoal() const {
-  return GetIntValue("linesgoal");
-}
 
-int Parser::GetMaxGapToWin() const {
-  return GetIntValue("maxgaptowin");
-}
+// Primitives
 
-int Parser::GetTolerance() const {
-  return GetIntValue("tolerance");
+int Parser::GetInt(QXmlStreamAttributes const& p_attributes, QString const& p_attributeName, int p_default) {
+  return p_attributes.hasAttribute(p_attributeName) ? p_attributes.value(p_attributeName).toInt() : p_default;
 }
 
-int Parser::GetStarsCount() const {
-  return GetIntValue("starscount");
+double Parser::GetDouble(QXmlStreamAttributes const& p_attributes, QString const& p_attributeName, double p_default) {
+  return p_attributes.hasAttribute(p_attributeName) ? p_attributes.value(p_attributeName).toDouble() : p_default;
 }
 
 
 // Polygon
 
-ppxl::Point Parser::GetPoint(QDomElement const& p_element) const {
-  return ppxl::Point(GetDouble(p_element, "x"), GetDouble(p_element, "y"));
-}
+ppxl::Polygon Parser::ReadPolygon(QXmlStreamReader& p_reader) const {
+  ppxl::Polygon polygon;
 
-ppxl::Segment Parser::GetSegment(QDomElement const& p_element) const {
-  QDomNodeList bounds = p_element.elementsByTagName("bound");
-  if (bounds.size() != 2) {
-    qDebug() << "Cannot create segment whithin Parser::createSegment: file corrupted";
-    return ppxl::Segment();
+  std::vector<ppxl::Point> vertices;
+  while (p_reader.readNextStartElement()) {
+    if (p_reader.name() == QLatin1String("vertex")) {
+      QXmlStreamAttributes attributes = p_reader.attributes();
+      vertices.emplace_back(GetDouble(attributes, "x"), GetDouble(attributes, "y"));
+    }
+    p_reader.skipCurrentElement();
   }
-  return ppxl::Segment(GetPoint(bounds.at(0).toElement()), GetPoint(bounds.at(1).toElement()));
-}
-
-ppxl::Polygon Parser::GetPolygon(QDomElement const& p_element) const {
-  ppxl::Polygon polygon;
 
-  QDomNodeList vertices = p_element.elementsByTagName("vertex");
   if (vertices.size() < 3) {
-    qDebug() << "Cannot create polygon whithin Parser::createPolygon: file corrupted";
+    qDebug() << "Cannot create polygon whithin Parser::ReadPolygon: file corrupted";
     return polygon;
   }
-  for (int k = 0; k < vertices.size(); k++) {
-    polygon << GetPoint(vertices.at(k).toElement());
-  }
+  polygon << vertices;
 
   return polygon;
 }
 
-QDomElement Parser::GetPolygonById(int p_id) const {
-  return GetElementById(m_polygons, "polygon", p_id);
-}
-
-PolygonsList Parser::GetPolygonsList() const {
-  PolygonsList polygonList;
-  for (int k = 0; k < m_polygonNodesCount; ++k) {
-    polygonList << GetPolygon(GetPolygonById(k));
-  }
-
-  return polygonList;
-}
-
 
 // Tape
 
-Tape Parser::GetTape(QDomElement const& p_element) const {
+Tape Parser::GetTape(QXmlStreamAttributes const& p_attributes) const {
   return Tape(
-    p_element.attribute("x", "-1.").toDouble(),
-    p_element.attribute("y", "-1.").toDouble(),
-    p_element.attribute("w", "-1.").toDouble(),
-    p_element.attribute("h", "-1.").toDouble()
+    GetDouble(p_attributes, "x", -1.),
+    GetDouble(p_attributes, "y", -1.),
+    GetDouble(p_attributes, "w", -1.),
+    GetDouble(p_attributes, "h", -1.)
   );
 }
 
-QDomElement Parser::GetTapeById(int p_id) const {
-  return GetElementById(m_tapes, "tape", p_id);
-}
-
-TapesList Parser::GetTapesList() {
-  TapesList tapeList;
-  for (int k = 0; k < m_tapeNodesCount; ++k) {
-    tapeList << GetTape(GetTapeById(k));
-  }
-
-  return tapeList;
-}
-
 
 // One Way
 
-OneWay Parser::GetOneWay(QDomElement const& p_element) const {
+OneWay Parser::GetOneWay(QXmlStreamAttributes const& p_attributes) const {
   return OneWay(
-    p_element.attribute("xa", "-1.").toDouble(),
-    p_element.attribute("ya", "-1.").toDouble(),
-    p_element.attribute("xb", "-1.").toDouble(),
-    p_element.attribute("yb", "-1.").toDouble()
+    GetDouble(p_attributes, "xa", -1.),
+    GetDouble(p_attributes, "ya", -1.),
+    GetDouble(p_attributes, "xb", -1.),
+    GetDouble(p_attributes, "yb", -1.)
   );
 }
 
-QDomElement Parser::GetOneWayById(int p_id) const {
-  return GetElementById(m_oneWays, "oneway", p_id);
-}
-
-OneWaysList Parser::GetOneWaysList() const {
-  OneWaysList oneWayList;
-  for (int k = 0; k < m_oneWayNodesCount; ++k) {
-    oneWayList << GetOneWay(GetOneWayById(k));
-  }
-
-  return oneWayList;
-}
-
 
 // Mirror
 
-Mirror Parser::GetMirror(QDomElement const& p_element) const {
+Mirror Parser::GetMirror(QXmlStreamAttributes const& p_attributes) const {
   return Mirror(
-    p_element.attribute("xa", "-1.").toDouble(),
-    p_element.attribute("ya", "-1.").toDouble(),
-    p_element.attribute("xb", "-1.").toDouble(),
-    p_element.attribute("yb", "-1.").toDouble()
+    GetDouble(p_attributes, "xa", -1.),
+    GetDouble(p_attributes, "ya", -1.),
+    GetDouble(p_attributes, "xb", -1.),
+    GetDouble(p_attributes, "yb", -1.)
   );
 }
 
-QDomElement Parser::GetMirrorById(int p_id) const {
-  return GetElementById(m_mirrors, "mirror", p_id);
-}
-
-MirrorsList Parser::GetMirrorsList() const {
-  MirrorsList mirrorList;
-  for (int k = 0; k < m_mirrorNodesCount; ++k) {
-    mirrorList << GetMirror(GetMirrorById(k));
-  }
-
-  return mirrorList;
-}
-
 
 // Portal
 
-Portal Parser::GetPortal(QDomElement const& p_element) const {
+Portal Parser::GetPortal(QXmlStreamAttributes const& p_attributes) const {
   return Portal(
-    p_element.attribute("xaIn", "-1.").toDouble(),
-    p_element.attribute("yaIn", "-1.").toDouble(),
-    p_element.attribute("xbIn", "-1.").toDouble(),
-    p_element.attribute("ybIn", "-1.").toDouble(),
-    p_element.attribute("xaOut", "-1.").toDouble(),
-    p_element.attribute("yaOut", "-1.").toDouble(),
-    p_element.attribute("xbOut", "-1.").toDouble(),
-    p_element.attribute("ybOut", "-1").toDouble()
+    GetDouble(p_attributes, "xaIn", -1.),
+    GetDouble(p_attributes, "yaIn", -1.),
+    GetDouble(p_attributes, "xbIn", -1.),
+    GetDouble(p_attributes, "ybIn", -1.),
+    GetDouble(p_attributes, "xaOut", -1.),
+    GetDouble(p_attributes, "yaOut", -1.),
+    GetDouble(p_attributes, "xbOut", -1.),
+    GetDouble(p_attributes, "ybOut", -1.)
   );
 }
-
-QDomElement Parser::GetPortalById(int p_id) const {
-  return GetElementById(m_portals, "portal", p_id);
-}
-
-PortalsList Parser::GetPortalsList() const {
-  PortalsList portalList;
-  for (int k = 0; k < m_portalNodesCount; ++k) {
-    portalList << GetPortal(GetPortalById(k));
-  }
-
-  return portalList;
-}
@@ -1,85 +1,52 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-#include <QtXml/QDomElement>
+#include <QString>
 
-#include "Core/Geometry/Point.hxx"
-#include "Core/Geometry/Segment.hxx"
-#include "Core/Geometry/Polygon.hxx"
-#include "Core/Objects/Obstacles/Tape.hxx"
-#include "Core/Objects/Obstacles/OneWay.hxx"
-#include "Core/Objects/Deviations/Mirror.hxx"
-#include "Core/Objects/Deviations/Portal.hxx"
+#include "Parser/Level.hxx"
 
-using PolygonsList = QList<ppxl::Polygon>;
-using TapesList = QList<Tape>;
-using OneWaysList = QList<OneWay>;
-using MirrorsList = QList<Mirror>;
-using PortalsList = QList<Portal>;
+class QXmlStreamReader;
+class QXmlStreamAttributes;
 
+// Reads a .ppxl file in a single pass, straight into a Level. .ppxlb files go through BinaryLevel.
 class Parser {
 public:
-  Parser();
   Parser(QString const& p_xmlFileName);
   virtual ~Parser();
 
-  // Primitives
-  int GetInt(QDomElement const& p_element, QString const& p_attributeName) const;
-  double GetDouble(QDomElement const& p_element, QString const& p_attributeName) const;
-  int GetIntValue(QString const& p_tagName, QString const& p_attributeName = "value") const;
-  QDomElement GetElementById(QDomElement const& p_parent, QString const& p_name, int p_id) const;
-  inline QDomDocument GetDoc() const { return m_doc; }
+  inline Level const& GetLevel() const { return m_level; }
 
   // Game Infos
-  int GetPartsGoal() const;
-  int GetLinesGoal() const;
-  int GetMaxGapToWin() const;
-  int GetTolerance() const;
-  int GetStarsCount() const;
-
-  // Polygon
-  ppxl::Point GetPoint(QDomElement const& p_element) const;
-  ppxl::Segment GetSegment(QDomElement const& p_element) const;
-  ppxl::Polygon GetPolygon(QDomElement const& p_element) const;
-  QDomElement GetPolygonById(int p_id) const;
-  PolygonsList GetPolygonsList() const;
-  inline int GetPolygonNodesCount() const { return m_polygonNodesCount; }
+  inline int GetPartsGoal() const { return m_level.m_partsGoal; }
+  inline int GetLinesGoal() const { return m_level.m_linesGoal; }
+  inline int GetMaxGapToWin() const { return m_level.m_maxGapToWin; }
+  inline int GetTolerance() const { return m_level.m_tolerance; }
+  inline int GetStarsCount() const { return m_level.m_starsCount; }
+
+  // Polygons and objects
+  inline PolygonsList const& GetPolygonsList() const { return m_level.m_polygonsList; }
+  inline int GetPolygonNodesCount() const { return m_level.m_polygonsList.size(); }
+  inline TapesList const& GetTapesList() const { return m_level.m_tapesList; }
+  inline OneWaysList const& GetOneWaysList() const { return m_level.m_oneWaysList; }
+  inline MirrorsList const& GetMirrorsList() const { return m_level.m_mirrorsList; }
+  inline PortalsList const& GetPortalsList() const { return m_level.m_portalsList; }
 
-  // Tape
-  Tape GetTape(QDomElement const& p_element) const;
-  QDomElement GetTapeById(int p_id) const;
-  TapesList GetTapesList();
-
-  // OneWay
-  OneWay GetOneWay(QDomElement const& p_element) const;
-  QDomElement GetOneWayById(int p_id) const;
-  OneWaysList GetOneWaysList() const;
+private:
+  void ReadLevel(QXmlStreamReader& p_reader);
+  void TraceLevel() const;
+  ppxl::Polygon ReadPolygon(QXmlStreamReader& p_reader) const;
 
-  // Mirror
-  Mirror GetMirror(QDomElement const& p_element) const;
-  QDomElement GetMirrorById(int p_id) const;
-  MirrorsList GetMirrorsList() const;
+  // Primitives
+  static int GetInt(QXmlStreamAttributes const& p_attributes, QString const& p_attributeName, int p_default = 0);
+  static double GetDouble(QXmlStreamAttributes const& p_attributes, QString const& p_attributeName, double p_default = 0.);
 
-  // Portal
-  Portal GetPortal(QDomElement const& p_element) const;
-  QDomElement GetPortalById(int p_id) const;
-  PortalsList GetPortalsList() const;
+  Tape GetTape(QXmlStreamAttributes const& p_attributes) const;
+  OneWay GetOneWay(QXmlStreamAttributes const& p_attributes) const;
+  Mirror GetMirror(QXmlStreamAttributes const& p_attributes) const;
+  Portal GetPortal(QXmlStreamAttributes const& p_attributes) const;
 
-private:
   QString m_xmlFileName;
-  QDomDocument m_doc;
-
-  QDomElement m_polygons;
-  QDomElement m_tapes;
-  QDomElement m_oneWays;
-  QDomElement m_mirrors;
-  QDomElement m_portals;
-
-  int m_polygonNodesCount;
-  int m_tapeNodesCount;
-  int m_oneWayNodesCount;
-  int m_mirrorNodesCount;
-  int m_portalNodesCount;
+  Level m_level;
 };
 
 #endif
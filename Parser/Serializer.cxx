@@ -1,23 +1,89 @@
 #include "Serializer.hxx"
 
-#include <cmath>
-
-#include <QFile>
 #include <QDebug>
+#include <QLocale>
+#include <QSaveFile>
+#include <QXmlStreamWriter>
+
+namespace {
+
+// Shortest representation that reads back to the same double
+QString DoubleToString(double p_value) {
+  return QString::number(p_value, 'g', QLocale::FloatingPointShortest);
+}
+
+void WriteGoal(QXmlStreamWriter& p_writer, QString const& p_tagName, int p_value) {
+  // Parser reads a missing goal as -1
+  if (p_value == -1) {
+    return;
+  }
+  p_writer.writeEmptyElement(p_tagName);
+  p_writer.writeAttribute("value", QString::number(p_value));
+}
+
+void WritePolygon(QXmlStreamWriter& p_writer, ppxl::Polygon const& p_polygon) {
+  for (auto const& vertex: p_polygon.GetVertices()) {
+    p_writer.writeEmptyElement("vertex");
+    p_writer.writeAttribute("x", DoubleToString(vertex.GetX()));
+    p_writer.writeAttribute("y", DoubleToString(vertex.GetY()));
+  }
+}
+
+void WriteTape(QXmlStreamWriter& p_writer, Tape const& p_tape) {
+  p_writer.writeAttribute("x", DoubleToString(p_tape.GetXmin()));
+  p_writer.writeAttribute("y", DoubleToString(p_tape.GetYmin()));
+  p_writer.writeAttribute("w", DoubleToString(p_tape.GetW()));
+  p_writer.writeAttribute("h", DoubleToString(p_tape.GetH()));
+}
+
+void WriteLine(QXmlStreamWriter& p_writer, ppxl::Segment const& p_line, QString const& p_suffix = QString()) {
+  p_writer.writeAttribute("xa" + p_suffix, DoubleToString(p_line.GetA().GetX()));
+  p_writer.writeAttribute("ya" + p_suffix, DoubleToString(p_line.GetA().GetY()));
+  p_writer.writeAttribute("xb" + p_suffix, DoubleToString(p_line.GetB().GetX()));
+  p_writer.writeAttribute("yb" + p_suffix, DoubleToString(p_line.GetB().GetY()));
+}
+
+void WriteOneWay(QXmlStreamWriter& p_writer, OneWay const& p_oneWay) {
+  WriteLine(p_writer, p_oneWay.GetLine());
+}
+
+void WriteMirror(QXmlStreamWriter& p_writer, Mirror const& p_mirror) {
+  WriteLine(p_writer, p_mirror.GetLine());
+}
+
+void WritePortal(QXmlStreamWriter& p_writer, Portal const& p_portal) {
+  WriteLine(p_writer, p_portal.GetIn(), "In");
+  WriteLine(p_writer, p_portal.GetOut(), "Out");
+}
+
+// Elements given without an id, e.g. through SetLevel, keep their index as id
+void AppendId(std::vector<int>& p_ids, int p_previousCount, int p_id) {
+  while (static_cast<int>(p_ids.size()) < p_previousCount) {
+    p_ids.push_back(static_cast<int>(p_ids.size()));
+  }
+  p_ids.push_back(p_id);
+}
+
+// <p_listTagName><p_tagName id="..." .../>...</p_listTagName>, p_writeElement writing the content of each element
+template<typename T, typename WriteElement>
+void WriteList(QXmlStreamWriter& p_writer, QString const& p_listTagName, QString const& p_tagName, QList<T> const& p_list,
+               std::vector<int> const& p_ids, WriteElement p_writeElement) {
+  p_writer.writeStartElement(p_listTagName);
+  for (int k = 0; k < p_list.size(); ++k) {
+    p_writer.writeStartElement(p_tagName);
+    p_writer.writeAttribute("id", QString::number(p_ids.empty() ? k : p_ids[static_cast<std::size_t>(k)]));
+    p_writeElement(p_writer, p_list.at(k));
+    p_writer.writeEndElement();
+  }
+  p_writer.writeEndElement();
+}
+
+}
 
 Serializer::Serializer(QString const& p_xmlFileName):
   m_xmlFileName(p_xmlFileName),
-  m_doc(QDomDocument("PPXLML")),
-  m_polygons(m_doc.createElement("polygons")),
-  m_tapes(m_doc.createElement("tapes")),
-  m_oneWays(m_doc.createElement("oneways")),
-  m_mirrors(m_doc.createElement("mirrors")),
-  m_portals(m_doc.createElement("portals")),
-  m_linesGoal(m_doc.createElement("linesgoal")),
-  m_partsGoal(m_doc.createElement("partsgoal")),
-  m_maxGapToWin(m_doc.createElement("maxgaptowin")),
-  m_tolerance(m_doc.createElement("tolerance")),
-  m_starsCount(m_doc.createElement("starscount")) {
+  m_level(),
+  m_ids() {
 }
 
 Serializer::~Serializer() = default;
@@ -25,89 +91,90 @@ Serializer::~Serializer() = default;
 
 // Serialize
 
-void Serializer::WriteXML(int p_indent) {
-  QFile XMLDoc(m_xmlFileName);
-  if(!XMLDoc.open(QIODevice::WriteOnly)) {
-    qDebug() << "Cannot open XML file in Serializer::writeXML\n" << XMLDoc.errorString();
-    return;
-  }
-
-  QDomElement root = m_doc.createElement("level");
-  m_doc.appendChild(root);
-  root.appendChild(m_polygons);
+bool Serializer::WriteXML(int p_indent) {
+  return Write(m_level, m_ids, m_xmlFileName, p_indent);
+}
 
-  auto objectsElement = m_doc.createElement("objects");
-  root.appendChild(objectsElement);
-  auto obstaclesElement = m_doc.createElement("obstacles");
-  objectsElement.appendChild(obstaclesElement);
-  obstaclesElement.appendChild(m_tapes);
-  obstaclesElement.appendChild(m_oneWays);
-  auto deviationsElement = m_doc.createElement("deviations");
-  objectsElement.appendChild(deviationsElement);
-  deviationsElement.appendChild(m_mirrors);
-  deviationsElement.appendChild(m_portals);
+bool Serializer::WriteLevel(Level const& p_level, QString const& p_xmlFileName, int p_indent) {
+  return Write(p_level, Ids(), p_xmlFileName, p_indent);
+}
 
-  root.appendChild(m_linesGoal);
-  root.appendChild(m_partsGoal);
-  root.appendChild(m_maxGapToWin);
-  root.appendChild(m_tolerance);
-  root.appendChild(m_starsCount);
+bool Serializer::Write(Level const& p_level, Ids const& p_ids, QString const& p_xmlFileName, int p_indent) {
+  QSaveFile XMLDoc(p_xmlFileName);
+  if(!XMLDoc.open(QIODevice::WriteOnly)) {
+    qDebug() << "Cannot open XML file in Serializer::Write\n" << XMLDoc.errorString();
+    return false;
+  }
 
-  QTextStream inFile(&XMLDoc);
-  inFile << m_doc.toString(p_indent);
+  QXmlStreamWriter writer(&XMLDoc);
+  writer.setAutoFormatting(true);
+  writer.setAutoFormattingIndent(p_indent);
+
+  writer.writeDTD("<!DOCTYPE PPXLML>");
+  writer.writeStartElement("level");
+  WriteList(writer, "polygons", "polygon", p_level.m_polygonsList, p_ids.m_polygonsIds, WritePolygon);
+
+  writer.writeStartElement("objects");
+  writer.writeStartElement("obstacles");
+  WriteList(writer, "tapes", "tape", p_level.m_tapesList, p_ids.m_tapesIds, WriteTape);
+  WriteList(writer, "oneways", "oneway", p_level.m_oneWaysList, p_ids.m_oneWaysIds, WriteOneWay);
+  writer.writeEndElement();
+  writer.writeStartElement("deviations");
+  WriteList(writer, "mirrors", "mirror", p_level.m_mirrorsList, p_ids.m_mirrorsIds, WriteMirror);
+  WriteList(writer, "portals", "portal", p_level.m_portalsList, p_ids.m_portalsIds, WritePortal);
+  writer.writeEndElement();
+  writer.writeEndElement();
+
+  WriteGoal(writer, "linesgoal", p_level.m_linesGoal);
+  WriteGoal(writer, "partsgoal", p_level.m_partsGoal);
+  WriteGoal(writer, "maxgaptowin", p_level.m_maxGapToWin);
+  WriteGoal(writer, "tolerance", p_level.m_tolerance);
+  WriteGoal(writer, "starscount", p_level.m_starsCount);
+  writer.writeEndElement();
+  writer.writeEndDocument();
+
+  if (writer.hasError() || !XMLDoc.commit()) {
+    qDebug() << "Cannot write XML file in Serializer::Write\n" << XMLDoc.errorString();
+    return false;
+  }
 
-  XMLDoc.close();
+  return true;
 }
 
 
 // Game Infos
 
 void Serializer::SetLinesGoal(int p_linesGoal) {
-  m_linesGoal.setAttribute("value", p_linesGoal);
+  m_level.m_linesGoal = p_linesGoal;
 }
 
 void Serializer::SetPartsGoal(int p_partsGoal) {
-  m_partsGoal.setAttribute("value", p_partsGoal);
+  m_level.m_partsGoal = p_partsGoal;
 }
 
 void Serializer::SetMaxGapToWin(int p_maxGapToWin) {
-  m_maxGapToWin.setAttribute("value", p_maxGapToWin);
+  m_level.m_maxGapToWin = p_maxGapToWin;
 }
 
 void Serializer::SetTolerance(int p_tolerance) {
-  m_tolerance.setAttribute("value", p_tolerance);
+  m_level.m_tolerance = p_tolerance;
 }
 
 void Serializer::SetStarsCount(int p_starscount) {
-  m_starsCount.setAttribute("value", p_starscount);
-}
-
-
-// Polygon
-
-QDomElement Serializer::PointToNode(ppxl::Point const& p_point, QString const& p_nodeName) {
-  QDomElement element(m_doc.createElement(p_nodeName));
-  element.setAttribute("x", p_point.GetX());
-  element.setAttribute("y", p_point.GetY());
-  return element;
+  m_level.m_starsCount = p_starscount;
 }
 
-QDomElement Serializer::SegmentToNode(ppxl::Segment const& p_segment) {
-  QDomElement element(m_doc.createElement("Line"));
-  element.appendChild(PointToNode(p_segment.GetA(), "bound"));
-  element.appendChild(PointToNode(p_segment.GetB(), "bound"));
-  return element;
+void Serializer::SetLevel(Level const& p_level) {
+  m_level = p_level;
+  m_ids = Ids();
 }
 
-void Serializer::AppendPolygon(ppxl::Polygon const& p_polygon, int p_id) {
-  QDomElement element(m_doc.createElement("polygon"));
-  element.setAttribute("id", p_id);
 
-  for (auto const& vertex: p_polygon.GetVertices()) {
-    element.appendChild(PointToNode(vertex, "vertex"));
-  }
+// Polygon
 
-  m_polygons.appendChild(element);
+void Serializer::AppendPolygon(ppxl::Polygon const& p_polygon, int p_id) {
+  AppendId(m_ids.m_polygonsIds, m_level.m_polygonsList.size(), p_id);
+  m_level.m_polygonsList << p_polygon;
 }
 
 void Serializer::SetPolygonsList(QList<ppxl::Polygon> const& p_polygons) {
@@ -121,20 +188,9 @@ void Serializer::SetPolygonsList(QList<ppxl::Polygon> const& p_polygons) {
 
 // Tape
 
-QDomElement Serializer::TapeToNode(Tape const& p_tape, int p_id) {
-  QDomElement element(m_doc.createElement("tape"));
-  element.setAttribute("id", p_id);
-
-  element.setAttribute("x", p_tape.GetXmin());
-  element.setAttribute("y", p_tape.GetYmin());
-  element.setAttribute("w", p_tape.GetW());
-  element.setAttribute("h", p_tape.GetH());
-
-  return element;
-}
-
 void Serializer::AppendTape(Tape const& p_tape, int p_id) {
-  m_tapes.appendChild(TapeToNode(p_tape, p_id));
+  AppendId(m_ids.m_tapesIds, m_level.m_tapesList.size(), p_id);
+  m_level.m_tapesList << p_tape;
 }
 
 void Serializer::SetTapeList(const QList<Tape*>& p_tapes) {
@@ -148,19 +204,6 @@ void Serializer::SetTapeList(const QList<Tape*>& p_tapes) {
 
 // OneWay
 
-QDomElement Serializer::OneWayToNode(OneWay const& p_oneWay, int p_id) {
-  QDomElement element(m_doc.createElement("oneway"));
-  element.setAttribute("id", p_id);
-
-  ppxl::Segment line(p_oneWay.GetLine());
-  element.setAttribute("xa", static_cast<int>(std::round(line.GetA().GetX())));
-  element.setAttribute("ya", static_cast<int>(std::round(line.GetA().GetY())));
-  element.setAttribute("xb", static_cast<int>(std::round(line.GetB().GetX())));
-  element.setAttribute("yb", static_cast<int>(std::round(line.GetB().GetY())));
-
-  return element;
-}
-
 void Serializer::SetOneWaysList(const QList<OneWay*>& p_oneWays) {
   int id = 0;
   for (auto const* oneWay: p_oneWays) {
@@ -170,27 +213,16 @@ void Serializer::SetOneWaysList(const QList<OneWay*>& p_oneWays) {
 }
 
 void Serializer::AppendOneWay(OneWay const& p_oneWay, int p_id) {
-  m_oneWays.appendChild(OneWayToNode(p_oneWay, p_id));
+  AppendId(m_ids.m_oneWaysIds, m_level.m_oneWaysList.size(), p_id);
+  m_level.m_oneWaysList << p_oneWay;
 }
 
 
 // Mirror
 
-QDomElement Serializer::MirrorToNode(Mirror const& p_mirror, int p_id) {
-  QDomElement element(m_doc.createElement("mirror"));
-  element.setAttribute("id", p_id);
-
-  ppxl::Segment mirrorLine(p_mirror.GetLine());
-  element.setAttribute("xa", static_cast<int>(std::round(mirrorLine.GetA().GetX())));
-  element.setAttribute("ya", static_cast<int>(std::round(mirrorLine.GetA().GetY())));
-  element.setAttribute("xb", static_cast<int>(std::round(mirrorLine.GetB().GetX())));
-  element.setAttribute("yb", static_cast<int>(std::round(mirrorLine.GetB().GetY())));
-
-  return element;
-}
-
 void Serializer::AppendMirror(Mirror const& p_mirror, int p_id) {
-  m_mirrors.appendChild(MirrorToNode(p_mirror, p_id));
+  AppendId(m_ids.m_mirrorsIds, m_level.m_mirrorsList.size(), p_id);
+  m_level.m_mirrorsList << p_mirror;
 }
 
 void Serializer::SetMirrorsList(QList<Mirror*> const& p_mirrors) {
@@ -204,27 +236,9 @@ void Serializer::SetMirrorsList(QList<Mirror*> const& p_mirrors) {
 
 // Portal
 
-QDomElement Serializer::PortalToNode(Portal const& p_portal, int p_id) {
-  QDomElement element(m_doc.createElement("portal"));
-  element.setAttribute("id", p_id);
-
-  ppxl::Segment portalLineIn(p_portal.GetIn());
-  element.setAttribute("xaIn", static_cast<int>(std::round(portalLineIn.GetA().GetX())));
-  element.setAttribute("yaIn", static_cast<int>(std::round(portalLineIn.GetA().GetY())));
-  element.setAttribute("xbIn", static_cast<int>(std::round(portalLineIn.GetB().GetX())));
-  element.setAttribute("ybIn", static_cast<int>(std::round(portalLineIn.GetB().GetY())));
-
-  ppxl::Segment portalLineOut(p_portal.GetOut());
-  element.setAttribute("xaOut", static_cast<int>(std::round(portalLineOut.GetA().GetX())));
-  element.setAttribute("yaOut", static_cast<int>(std::round(portalLineOut.GetA().GetY())));
-  element.setAttribute("xbOut", static_cast<int>(std::round(portalLineOut.GetB().GetX())));
-  element.setAttribute("ybOut", static_cast<int>(std::round(portalLineOut.GetB().GetY())));
-
-  return element;
-}
-
 void Serializer::AppendPortal(Portal const& p_portal, int p_id) {
-  m_portals.appendChild(PortalToNode(p_portal, p_id));
+  AppendId(m_ids.m_portalsIds, m_level.m_portalsList.size(), p_id);
+  m_level.m_portalsList << p_portal;
 }
 
 void Serializer::SetPortalsList(const QList<Portal*>& p_portals) {
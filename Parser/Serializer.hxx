@@ -1,7 +1,9 @@
 #ifndef SERIALIZER_HXX
 #define SERIALIZER_HXX
 
-#include <QtXml/QDomElement>
+#include <QString>
+
+#include <vector>
 
 #include "Core/Geometry/Point.hxx"
 #include "Core/Geometry/Segment.hxx"
@@ -10,7 +12,10 @@
 #include "Core/Objects/Obstacles/OneWay.hxx"
 #include "Core/Objects/Deviations/Mirror.hxx"
 #include "Core/Objects/Deviations/Portal.hxx"
+#include "Parser/Level.hxx"
 
+// Writes .ppxl files. Elements are streamed straight from the lists into a temporary file, which
+// replaces the level only once complete: a crash while saving never leaves a truncated level.
 class Serializer {
 public:
 //  Serializer();
@@ -19,7 +24,9 @@ public:
   virtual ~Serializer();
 
   // Serialize
-  void WriteXML(int p_indent = 2);
+  bool WriteXML(int p_indent = 2);
+  // Without copying p_level, e.g. from a snapshot on a worker thread; elements ids are their indices
+  static bool WriteLevel(Level const& p_level, QString const& p_xmlFileName, int p_indent = 2);
 
   // GameInfos
   void SetPartsGoal(int p_partsGoal = 1);
@@ -28,46 +35,44 @@ public:
   void SetTolerance(int p_tolerance = 1);
   void SetStarsCount(int p_starscount = 0);
 
+  // Whole level, as read by Parser
+  void SetLevel(Level const& p_level);
+
   // Polygon
-  QDomElement PointToNode(ppxl::Point const& p_point, QString const& p_nodeName);
-  QDomElement SegmentToNode(ppxl::Segment const& p_segment);
   void AppendPolygon(ppxl::Polygon const& p_polygon, int p_id);
   void SetPolygonsList(const QList<ppxl::Polygon>& p_polygons);
 
   // Tape
-  QDomElement TapeToNode(Tape const& p_tape, int p_id);
   void AppendTape(Tape const& p_tape, int p_id);
   void SetTapeList(QList<Tape*> const& p_tapes);
 
   // OneWay
-  QDomElement OneWayToNode(OneWay const& p_oneWay, int p_id);
   void AppendOneWay(OneWay const& p_oneWay, int p_id);
   void SetOneWaysList(QList<OneWay*> const& p_oneWays);
 
   // Mirror
-  QDomElement MirrorToNode(Mirror const& p_mirror, int p_id);
   void AppendMirror(Mirror const& p_mirror, int p_id);
   void SetMirrorsList(QList<Mirror*> const& p_mirrors);
 
   // Portal
-  QDomElement PortalToNode(Portal const& p_portal, int p_id);
   void AppendPortal(Portal const& p_portal, int p_id);
   void SetPortalsList(QList<Portal*> const& p_portals);
 
 private:
+  // Ids of each list's elements, empty when they are the indices
+  struct Ids {
+    std::vector<int> m_polygonsIds;
+    std::vector<int> m_tapesIds;
+    std::vector<int> m_oneWaysIds;
+    std::vector<int> m_mirrorsIds;
+    std::vector<int> m_portalsIds;
+  };
+
+  static bool Write(Level const& p_level, Ids const& p_ids, QString const& p_xmlFileName, int p_indent);
+
   QString m_xmlFileName;
-  QDomDocument m_doc;
-
-  QDomElement m_polygons;
-  QDomElement m_tapes;
-  QDomElement m_oneWays;
-  QDomElement m_mirrors;
-  QDomElement m_portals;
-  QDomElement m_linesGoal;
-  QDomElement m_partsGoal;
-  QDomElement m_maxGapToWin;
-  QDomElement m_tolerance;
-  QDomElement m_starsCount;
+  Level m_level;
+  Ids m_ids;
 };
 
 #endif
@@ -0,0 +1,285 @@
+#include "WorldPack.hxx"
+
+#include "Parser/BinaryLevel.hxx"
+#include "Parser/Parser.hxx"
+
+#include <QDebug>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr char Magic[8] = {'P', 'P', 'X', 'L', 'P', 'A', 'C', 'K'};
+constexpr qint64 HeaderSize = 32;
+constexpr qint64 VersionOffset = 8;
+constexpr qint64 ThumbnailSizeOffset = 10;
+constexpr qint64 LevelsCountOffset = 12;
+constexpr qint64 MapOffsetOffset = 16;
+constexpr qint64 MapSizeOffset = 24;
+
+constexpr qint64 EntrySize = 64;
+constexpr qint64 PayloadOffsetOffset = 0;
+constexpr qint64 ThumbnailOffsetOffset = 8;
+constexpr qint64 NameOffsetOffset = 16;
+constexpr qint64 PayloadSizeOffset = 24;
+constexpr qint64 NameSizeOffset = 28;
+constexpr qint64 PolygonsCountOffset = 32;
+constexpr qint64 ObjectsCountOffset = 36;
+constexpr qint64 GoalsOffset = 40;
+constexpr int GoalsCount = 5;
+
+constexpr qint64 ThumbnailBytesCount = WorldPack::ThumbnailSize*WorldPack::ThumbnailSize;
+
+qint64 Align(qint64 p_offset) {
+  return (p_offset + 7) & ~qint64(7);
+}
+
+// Samples the center of each pixel, the level being centered and scaled to fit the thumbnail
+QByteArray RenderThumbnail(PolygonsList const& p_polygonsList) {
+  QByteArray thumbnail(static_cast<int>(ThumbnailBytesCount), '\0');
+
+  ppxl::BoundingBox box;
+  for (auto const& polygon: p_polygonsList) {
+    box.Extend(polygon.GetBoundingBox());
+  }
+  double width = box.GetXMax() - box.GetXMin();
+  double height = box.GetYMax() - box.GetYMin();
+  if (box.IsEmpty() || (width <= 0. && height <= 0.)) {
+    return thumbnail;
+  }
+
+  double pixelSize = std::max(width, height)/WorldPack::ThumbnailSize;
+  double xMin = box.GetXMin() - (pixelSize*WorldPack::ThumbnailSize - width)/2.;
+  double yMin = box.GetYMin() - (pixelSize*WorldPack::ThumbnailSize - height)/2.;
+  std::vector<ppxl::Point> centers;
+  centers.reserve(ThumbnailBytesCount);
+  for (int row = 0; row < WorldPack::ThumbnailSize; ++row) {
+    for (int column = 0; column < WorldPack::ThumbnailSize; ++column) {
+      centers.emplace_back(xMin + (column + 0.5)*pixelSize, yMin + (row + 0.5)*pixelSize);
+    }
+  }
+
+  for (auto const& polygon: p_polygonsList) {
+    auto inside = polygon.ArePointsInside(centers);
+    for (std::size_t k = 0; k < inside.size(); ++k) {
+      if (inside[k]) {
+        thumbnail[static_cast<int>(k)] = static_cast<char>(255);
+      }
+    }
+  }
+
+  return thumbnail;
+}
+
+bool IsInside(qint64 p_offset, qint64 p_size, qint64 p_totalSize) {
+  return p_offset >= 0 && p_size >= 0 && p_offset <= p_totalSize && p_size <= p_totalSize - p_offset;
+}
+
+}
+
+WorldPack::WorldPack():
+  m_file(),
+  m_bytes(),
+  m_data(nullptr),
+  m_mapped(false),
+  m_size(0),
+  m_levelsCount(0) {
+}
+
+WorldPack::~WorldPack() {
+  Close();
+}
+
+bool WorldPack::Write(QStringList const& p_levelsFileNames, QString const& p_mapFileName, QString const& p_packFileName) {
+  QFile mapFile(p_mapFileName);
+  if (!mapFile.open(QIODevice::ReadOnly)) {
+    qDebug() << "Cannot open map file in WorldPack::Write\n" << mapFile.errorString();
+    return false;
+  }
+  QByteArray map = mapFile.readAll();
+  mapFile.close();
+
+  struct PackedLevel {
+    QByteArray m_name;
+    QByteArray m_payload;
+    QByteArray m_thumbnail;
+    Level m_level;
+  };
+  std::vector<PackedLevel> packedLevels;
+  packedLevels.reserve(p_levelsFileNames.size());
+  for (auto const& levelFileName: p_levelsFileNames) {
+    Parser parser(levelFileName);
+    auto const& level = parser.GetLevel();
+    packedLevels.push_back({levelFileName.toUtf8(), BinaryLevel::Encode(level), RenderThumbnail(level.m_polygonsList), level});
+  }
+
+  qint64 levelsCount = static_cast<qint64>(packedLevels.size());
+  qint64 mapOffset = HeaderSize + EntrySize*levelsCount;
+  qint64 size = Align(mapOffset + map.size());
+  std::vector<qint64> namesOffsets, payloadsOffsets, thumbnailsOffsets;
+  for (auto const& packedLevel: packedLevels) {
+    namesOffsets.push_back(size);
+    size = Align(size + packedLevel.m_name.size());
+    payloadsOffsets.push_back(size);
+    size = Align(size + packedLevel.m_payload.size());
+    thumbnailsOffsets.push_back(size);
+    size = Align(size + packedLevel.m_thumbnail.size());
+  }
+
+  QByteArray bytes(static_cast<int>(size), '\0');
+  auto data = reinterpret_cast<uchar*>(bytes.data());
+  std::memcpy(data, Magic, sizeof(Magic));
+  qToLittleEndian(Version, data + VersionOffset);
+  qToLittleEndian(static_cast<quint16>(ThumbnailSize), data + ThumbnailSizeOffset);
+  qToLittleEndian(static_cast<quint32>(levelsCount), data + LevelsCountOffset);
+  qToLittleEndian(static_cast<quint64>(mapOffset), data + MapOffsetOffset);
+  qToLittleEndian(static_cast<quint32>(map.size()), data + MapSizeOffset);
+  std::memcpy(data + mapOffset, map.constData(), static_cast<std::size_t>(map.size()));
+
+  for (qint64 k = 0; k < levelsCount; ++k) {
+    auto const& packedLevel = packedLevels[k];
+    auto const& level = packedLevel.m_level;
+    uchar* entry = data + HeaderSize + EntrySize*k;
+    qToLittleEndian(static_cast<quint64>(payloadsOffsets[k]), entry + PayloadOffsetOffset);
+    qToLittleEndian(static_cast<quint64>(thumbnailsOffsets[k]), entry + ThumbnailOffsetOffset);
+    qToLittleEndian(static_cast<quint64>(namesOffsets[k]), entry + NameOffsetOffset);
+    qToLittleEndian(static_cast<quint32>(packedLevel.m_payload.size()), entry + PayloadSizeOffset);
+    qToLittleEndian(static_cast<quint32>(packedLevel.m_name.size()), entry + NameSizeOffset);
+    qToLittleEndian(static_cast<quint32>(level.m_polygonsList.size()), entry + PolygonsCountOffset);
+    qToLittleEndian(static_cast<quint32>(level.m_tapesList.size() + level.m_oneWaysList.size() + level.m_mirrorsList.size() + level.m_portalsList.size()),
+                    entry + ObjectsCountOffset);
+    qint32 goals[GoalsCount] = {level.m_linesGoal, level.m_partsGoal, level.m_maxGapToWin, level.m_tolerance, level.m_starsCount};
+    for (int goal = 0; goal < GoalsCount; ++goal) {
+      qToLittleEndian(goals[goal], entry + GoalsOffset + sizeof(qint32)*goal);
+    }
+
+    std::memcpy(data + namesOffsets[k], packedLevel.m_name.constData(), static_cast<std::size_t>(packedLevel.m_name.size()));
+    std::memcpy(data + payloadsOffsets[k], packedLevel.m_payload.constData(), static_cast<std::size_t>(packedLevel.m_payload.size()));
+    std::memcpy(data + thumbnailsOffsets[k], packedLevel.m_thumbnail.constData(), static_cast<std::size_t>(packedLevel.m_thumbnail.size()));
+  }
+
+  // Replaces the pack only once it is fully written, so that an interrupted write leaves the previous one
+  QSaveFile packFile(p_packFileName);
+  if (!packFile.open(QIODevice::WriteOnly)) {
+    qDebug() << "Cannot open world pack file in WorldPack::Write\n" << packFile.errorString();
+    return false;
+  }
+
+  return packFile.write(bytes) == bytes.size() && packFile.commit();
+}
+
+bool WorldPack::Open(QString const& p_packFileName) {
+  Close();
+
+  m_file.setFileName(p_packFileName);
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    qDebug() << "Cannot open world pack file in WorldPack::Open\n" << m_file.errorString();
+    return false;
+  }
+
+  m_size = m_file.size();
+  m_data = m_file.map(0, m_size);
+  m_mapped = m_data != nullptr;
+  if (!m_mapped) {
+    // Some file systems cannot be mapped
+    m_bytes = m_file.readAll();
+    m_data = reinterpret_cast<uchar const*>(m_bytes.constData());
+  }
+
+  if (!CheckIndex()) {
+    qDebug() << "Corrupted world pack file in WorldPack::Open:" << p_packFileName;
+    Close();
+    return false;
+  }
+  m_levelsCount = static_cast<int>(qFromLittleEndian<quint32>(m_data + LevelsCountOffset));
+
+  return true;
+}
+
+void WorldPack::Close() {
+  if (m_mapped) {
+    m_file.unmap(const_cast<uchar*>(m_data));
+  }
+  m_file.close();
+  m_bytes.clear();
+  m_data = nullptr;
+  m_mapped = false;
+  m_size = 0;
+  m_levelsCount = 0;
+}
+
+// Checks every range once, so that getters read the pack without further checks
+bool WorldPack::CheckIndex() const {
+  if (m_size < HeaderSize || std::memcmp(m_data, Magic, sizeof(Magic)) != 0) {
+    return false;
+  }
+  if (qFromLittleEndian<quint16>(m_data + VersionOffset) != Version || qFromLittleEndian<quint16>(m_data + ThumbnailSizeOffset) != ThumbnailSize) {
+    return false;
+  }
+
+  qint64 levelsCount = qFromLittleEndian<quint32>(m_data + LevelsCountOffset);
+  if (!IsInside(HeaderSize, EntrySize*levelsCount, m_size)) {
+    return false;
+  }
+  auto mapOffset = static_cast<qint64>(qFromLittleEndian<quint64>(m_data + MapOffsetOffset));
+  if (!IsInside(mapOffset, qFromLittleEndian<quint32>(m_data + MapSizeOffset), m_size)) {
+    return false;
+  }
+
+  for (qint64 k = 0; k < levelsCount; ++k) {
+    uchar const* entry = m_data + HeaderSize + EntrySize*k;
+    auto payloadOffset = static_cast<qint64>(qFromLittleEndian<quint64>(entry + PayloadOffsetOffset));
+    auto thumbnailOffset = static_cast<qint64>(qFromLittleEndian<quint64>(entry + ThumbnailOffsetOffset));
+    auto nameOffset = static_cast<qint64>(qFromLittleEndian<quint64>(entry + NameOffsetOffset));
+    if (!IsInside(payloadOffset, qFromLittleEndian<quint32>(entry + PayloadSizeOffset), m_size)
+     || !IsInside(thumbnailOffset, ThumbnailBytesCount, m_size)
+     || !IsInside(nameOffset, qFromLittleEndian<quint32>(entry + NameSizeOffset), m_size)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+uchar const* WorldPack::GetEntry(int p_index) const {
+  Q_ASSERT(0 <= p_index && p_index < m_levelsCount);
+  return m_data + HeaderSize + EntrySize*p_index;
+}
+
+WorldPack::LevelInfo WorldPack::GetLevelInfo(int p_index) const {
+  uchar const* entry = GetEntry(p_index);
+  auto nameOffset = qFromLittleEndian<quint64>(entry + NameOffsetOffset);
+  auto nameSize = qFromLittleEndian<quint32>(entry + NameSizeOffset);
+
+  LevelInfo levelInfo;
+  levelInfo.m_fileName = QString::fromUtf8(reinterpret_cast<char const*>(m_data + nameOffset), static_cast<int>(nameSize));
+  int* goals[GoalsCount] = {&levelInfo.m_linesGoal, &levelInfo.m_partsGoal, &levelInfo.m_maxGapToWin, &levelInfo.m_tolerance, &levelInfo.m_starsCount};
+  for (int goal = 0; goal < GoalsCount; ++goal) {
+    *goals[goal] = qFromLittleEndian<qint32>(entry + GoalsOffset + sizeof(qint32)*goal);
+  }
+  levelInfo.m_polygonsCount = static_cast<int>(qFromLittleEndian<quint32>(entry + PolygonsCountOffset));
+  levelInfo.m_objectsCount = static_cast<int>(qFromLittleEndian<quint32>(entry + ObjectsCountOffset));
+
+  return levelInfo;
+}
+
+uchar const* WorldPack::GetThumbnail(int p_index) const {
+  return m_data + qFromLittleEndian<quint64>(GetEntry(p_index) + ThumbnailOffsetOffset);
+}
+
+bool WorldPack::GetLevel(int p_index, Level& p_level) const {
+  uchar const* entry = GetEntry(p_index);
+  return BinaryLevel::Decode(m_data + qFromLittleEndian<quint64>(entry + PayloadOffsetOffset), qFromLittleEndian<quint32>(entry + PayloadSizeOffset), p_level);
+}
+
+QByteArray WorldPack::GetMap() const {
+  if (m_data == nullptr) {
+    return QByteArray();
+  }
+  auto mapOffset = qFromLittleEndian<quint64>(m_data + MapOffsetOffset);
+  return QByteArray(reinterpret_cast<char const*>(m_data + mapOffset), static_cast<int>(qFromLittleEndian<quint32>(m_data + MapSizeOffset)));
+}
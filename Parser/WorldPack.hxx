@@ -0,0 +1,68 @@
+#ifndef WORLDPACK_HXX
+#define WORLDPACK_HXX
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include "Parser/Level.hxx"
+
+// Single file holding a whole world: its map, every level as a BinaryLevel payload, and for each
+// level its goals, counts and a thumbnail. The file is memory-mapped when opened, so that listing
+// and previewing levels reads the index in place. Little-endian layout:
+//   header       magic "PPXLPACK", quint16 version, quint16 thumbnail size, quint32 levels count,
+//                quint64 map offset, quint32 map size, padding up to 32 bytes
+//   index        one 64-byte entry per level: quint64 payload, thumbnail and name offsets,
+//                quint32 payload size, name size, polygons count, objects count, qint32 goals[5]
+//   data         map text, level names, payloads and thumbnails, each starting on 8 bytes
+// Thumbnails are ThumbnailSize x ThumbnailSize bytes, 255 where a polygon covers the pixel.
+class WorldPack {
+public:
+  struct LevelInfo {
+    QString m_fileName;
+    int m_linesGoal;
+    int m_partsGoal;
+    int m_maxGapToWin;
+    int m_tolerance;
+    int m_starsCount;
+    int m_polygonsCount;
+    int m_objectsCount;
+  };
+
+  static constexpr char const* Suffix = "ppxlpack";
+  static constexpr quint16 Version = 1;
+  static constexpr int ThumbnailSize = 64;
+
+  WorldPack();
+  ~WorldPack();
+
+  // Reads every level with Parser, so that any level file format can be packed
+  static bool Write(QStringList const& p_levelsFileNames, QString const& p_mapFileName, QString const& p_packFileName);
+
+  bool Open(QString const& p_packFileName);
+  void Close();
+  inline bool IsOpen() const { return m_data != nullptr; }
+
+  inline int GetLevelsCount() const { return m_levelsCount; }
+  LevelInfo GetLevelInfo(int p_index) const;
+  // Points into the pack, valid until it is closed
+  uchar const* GetThumbnail(int p_index) const;
+  bool GetLevel(int p_index, Level& p_level) const;
+  QByteArray GetMap() const;
+
+private:
+  Q_DISABLE_COPY(WorldPack)
+
+  bool CheckIndex() const;
+  uchar const* GetEntry(int p_index) const;
+
+  QFile m_file;
+  QByteArray m_bytes;
+  uchar const* m_data;
+  bool m_mapped;
+  qint64 m_size;
+  int m_levelsCount;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include "Core/Solver/LevelSolver.hxx"
+#include "Parser/Parser.hxx"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <iostream>
+
+namespace {
+
+void PrintUsage() {
+  std::cerr << "Usage: SolveLevels [--beam WIDTH] [--samples COUNT] [--threads COUNT] [LEVEL.ppxl...]" << std::endl
+            << "Searches each level for at most linesgoal cuts giving partsgoal parts within maxgaptowin." << std::endl
+            << "Levels default to worlds/*.ppxl. Exits with 2 when a level is not solved." << std::endl;
+}
+
+std::vector<Object*> GetObjectsList(Level const& p_level) {
+  std::vector<Object*> objectsList;
+  for (auto const& tape: p_level.m_tapesList) {
+    objectsList.push_back(new Tape(tape));
+  }
+  for (auto const& oneWay: p_level.m_oneWaysList) {
+    objectsList.push_back(new OneWay(oneWay));
+  }
+  for (auto const& mirror: p_level.m_mirrorsList) {
+    objectsList.push_back(new Mirror(mirror));
+  }
+  for (auto const& portal: p_level.m_portalsList) {
+    objectsList.push_back(new Portal(portal));
+  }
+
+  return objectsList;
+}
+
+void WriteSolution(std::ostream& p_stream, LevelSolver::Solution const& p_solution, LevelSolver::Statistics const& p_statistics) {
+  p_stream << "      \"solved\": " << (p_solution.m_isSolved ? "true" : "false") << ",\n";
+  p_stream << "      \"lines\": [";
+  for (unsigned int k = 0; k < p_solution.m_lines.size(); ++k) {
+    auto const& line = p_solution.m_lines[k];
+    p_stream << (k == 0 ? "" : ", ") << "[" << line.GetA().GetX() << ", " << line.GetA().GetY()
+             << ", " << line.GetB().GetX() << ", " << line.GetB().GetY() << "]";
+  }
+  p_stream << "],\n";
+  p_stream << "      \"areas\": [";
+  for (unsigned int k = 0; k < p_solution.m_areas.size(); ++k) {
+    p_stream << (k == 0 ? "" : ", ") << p_solution.m_areas[k];
+  }
+  p_stream << "],\n";
+  p_stream << "      \"gap\": " << p_solution.m_gap << ",\n";
+  p_stream << "      \"statistics\": {"
+           << "\"candidate_lines\": " << p_statistics.m_candidateLinesCount
+           << ", \"threads\": " << p_statistics.m_threadsCount
+           << ", \"depth\": " << p_statistics.m_depthReached
+           << ", \"expanded_states\": " << p_statistics.m_expandedStatesCount
+           << ", \"slices\": " << p_statistics.m_slicesCount
+           << ", \"good_slices\": " << p_statistics.m_goodSlicesCount
+           << ", \"pruned_states\": " << p_statistics.m_prunedStatesCount
+           << ", \"duplicate_states\": " << p_statistics.m_duplicateStatesCount
+           << ", \"ms\": " << p_statistics.m_milliseconds << "}";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  LevelSolver::Options options;
+  QStringList levelsList;
+
+  for (int k = 1; k < argc; ++k) {
+    QString argument(argv[k]);
+    bool hasValue = k+1 < argc;
+    if (argument == "--beam" && hasValue) {
+      options.m_beamWidth = QString(argv[++k]).toUInt();
+    } else if (argument == "--samples" && hasValue) {
+      options.m_boundarySamplesCount = QString(argv[++k]).toUInt();
+    } else if (argument == "--threads" && hasValue) {
+      options.m_threadsCount = QString(argv[++k]).toUInt();
+    } else if (argument.startsWith("--")) {
+      PrintUsage();
+      return 1;
+    } else {
+      levelsList << argument;
+    }
+  }
+
+  if (levelsList.isEmpty()) {
+    QDir worldsDir("worlds");
+    for (auto const& fileName: worldsDir.entryList(QStringList() << "*.ppxl", QDir::Files, QDir::Name)) {
+      levelsList << worldsDir.filePath(fileName);
+    }
+  }
+  if (levelsList.isEmpty() || options.m_beamWidth == 0) {
+    PrintUsage();
+    return 1;
+  }
+
+  bool allSolved = true;
+  std::cout << "{\n  \"levels\": [\n";
+  for (int k = 0; k < levelsList.size(); ++k) {
+    QString const& levelFileName = levelsList.at(k);
+    Level level = Parser(levelFileName).GetLevel();
+    std::vector<ppxl::Polygon> polygonsList(level.m_polygonsList.begin(), level.m_polygonsList.end());
+    std::vector<Object*> objectsList = GetObjectsList(level);
+
+    std::cout << "    {\n";
+    std::cout << "      \"level\": \"" << QFileInfo(levelFileName).completeBaseName().toStdString() << "\",\n";
+    std::cout << "      \"lines_goal\": " << level.m_linesGoal << ",\n";
+    std::cout << "      \"parts_goal\": " << level.m_partsGoal << ",\n";
+    std::cout << "      \"max_gap\": " << level.m_maxGapToWin << ",\n";
+
+    LevelSolver solver(polygonsList, objectsList, {level.m_linesGoal, level.m_partsGoal, level.m_maxGapToWin});
+    if (!solver.HasValidGoals()) {
+      std::cout << "      \"solved\": false,\n      \"error\": \"missing polygons or goals\"";
+      allSolved = false;
+    } else {
+      LevelSolver::Solution solution = solver.Solve(options);
+      WriteSolution(std::cout, solution, solver.GetStatistics());
+      allSolved = allSolved && solution.m_isSolved;
+    }
+    std::cout << "\n    }" << (k+1 < levelsList.size() ? "," : "") << "\n";
+
+    for (auto object: objectsList) {
+      delete object;
+    }
+  }
+  std::cout << "  ]\n}" << std::endl;
+
+  return allSolved ? 0 : 2;
+}
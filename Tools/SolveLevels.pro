@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Headless level validation: searches each level for cuts meeting its
+# goals and prints the best solution and search statistics as JSON.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = SolveLevels
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Geometry and slicing engine, built by Core/ppxl-core.pro
+include(../Core/ppxl-core.pri)
+
+SOURCES += \
+    SolveLevels.cxx \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.cxx \
+    $$PWD/../Parser/Parser.cxx
+
+HEADERS += \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.hxx \
+    $$PWD/../Parser/Level.hxx \
+    $$PWD/../Parser/Parser.hxx
@@ -0,0 +1,101 @@
+#include "Core/Validator/LevelValidator.hxx"
+#include "Parser/BinaryLevel.hxx"
+#include "Parser/Parser.hxx"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <iostream>
+
+namespace {
+
+void PrintUsage() {
+  std::cerr << "Usage: ValidateLevels [--threads COUNT] [DIR|LEVEL...]" << std::endl
+            << "Checks every .ppxl and .ppxlb level of each DIR, worlds by default." << std::endl
+            << "Exits with 2 when a level has an issue." << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  unsigned int threadsCount = 0;
+  QStringList pathsList;
+
+  for (int k = 1; k < argc; ++k) {
+    QString argument(argv[k]);
+    bool hasValue = k+1 < argc;
+    if (argument == "--threads" && hasValue) {
+      threadsCount = QString(argv[++k]).toUInt();
+    } else if (argument.startsWith("--")) {
+      PrintUsage();
+      return 1;
+    } else {
+      pathsList << argument;
+    }
+  }
+  if (pathsList.isEmpty()) {
+    pathsList << "worlds";
+  }
+
+  QStringList levelsList;
+  QStringList filters = QStringList() << "*.ppxl" << QString("*.%1").arg(BinaryLevel::Suffix);
+  for (auto const& path: pathsList) {
+    if (QFileInfo(path).isDir()) {
+      QDir dir(path);
+      for (auto const& fileName: dir.entryList(filters, QDir::Files, QDir::Name)) {
+        levelsList << dir.filePath(fileName);
+      }
+    } else {
+      levelsList << path;
+    }
+  }
+  if (levelsList.isEmpty()) {
+    PrintUsage();
+    return 1;
+  }
+
+  LevelValidator validator(threadsCount);
+  bool allValid = true;
+  std::cout << "{\n  \"levels\": [\n";
+  for (int k = 0; k < levelsList.size(); ++k) {
+    QString const& levelFileName = levelsList.at(k);
+    Level level = Parser(levelFileName).GetLevel();
+    std::vector<ppxl::Polygon> polygonsList(level.m_polygonsList.begin(), level.m_polygonsList.end());
+
+    std::vector<LevelValidator::Issue> issues = validator.Validate(polygonsList);
+    auto const& statistics = validator.GetStatistics();
+    allValid = allValid && issues.empty();
+
+    std::cout << "    {\"level\": \"" << QFileInfo(levelFileName).fileName().toStdString() << "\""
+              << ", \"valid\": " << (issues.empty() ? "true" : "false")
+              << ", \"issues\": [";
+    for (unsigned int i = 0; i < issues.size(); ++i) {
+      auto const& issue = issues[i];
+      std::cout << (i == 0 ? "" : ", ") << "{\"type\": \"" << LevelValidator::GetIssueName(issue.m_type) << "\""
+                << ", \"polygon\": " << issue.m_polygon;
+      if (issue.m_type == LevelValidator::eOverlap) {
+        std::cout << ", \"other_polygon\": " << issue.m_otherPolygon;
+      }
+      if (!issue.m_crossingEdges.empty()) {
+        std::cout << ", \"crossing_edges\": [";
+        for (unsigned int e = 0; e < issue.m_crossingEdges.size(); ++e) {
+          auto const& edges = issue.m_crossingEdges[e];
+          std::cout << (e == 0 ? "" : ", ") << "[" << edges.first << ", " << edges.second << "]";
+        }
+        std::cout << "]";
+      }
+      std::cout << "}";
+    }
+    std::cout << "]"
+              << ", \"polygons\": " << statistics.m_polygonsCount
+              << ", \"pairs\": " << statistics.m_pairsCount
+              << ", \"candidate_pairs\": " << statistics.m_candidatePairsCount
+              << ", \"threads\": " << statistics.m_threadsCount
+              << ", \"ms\": " << statistics.m_milliseconds
+              << "}" << (k+1 < levelsList.size() ? "," : "") << "\n";
+  }
+  std::cout << "  ]\n}" << std::endl;
+
+  return allValid ? 0 : 2;
+}
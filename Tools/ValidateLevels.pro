@@ -0,0 +1,29 @@
+#-------------------------------------------------
+#
+# Headless level validation: checks the polygons of every level in a
+# directory for bad shapes and overlaps, and prints the issues as JSON.
+#
+#-------------------------------------------------
+
+QT       = core
+
+TARGET = ValidateLevels
+TEMPLATE = app
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+# Geometry and slicing engine, built by Core/ppxl-core.pro
+include(../Core/ppxl-core.pri)
+
+SOURCES += \
+    ValidateLevels.cxx \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.cxx \
+    $$PWD/../Parser/Parser.cxx
+
+HEADERS += \
+#PARSER
+    $$PWD/../Parser/BinaryLevel.hxx \
+    $$PWD/../Parser/Level.hxx \
+    $$PWD/../Parser/Parser.hxx